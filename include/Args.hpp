@@ -1,6 +1,7 @@
 #ifndef ARGS_HPP
 # define ARGS_HPP
 
+#include "defines.hpp"	// For Solver
 #include <string>
 
 /**
@@ -8,6 +9,9 @@
 
  This class will parse the arguments in its constructor.
  If parsing fails, it will throw an std::invalid_argument exception.
+
+ Positional arguments (`<n> [width] [height]`) may be mixed with
+ options starting with `--` (see `printUsage()`).
 */
 class Args
 {
@@ -18,11 +22,24 @@ class Args
 		int			n_orig;
 		int			width;
 		int			height;
+		double		tolerance;
+		int			max_iterations;
+		bool		auto_iterations;	// '--iters auto': pick budget from a probe pass
+		bool		fast_paths;			// '--fast on|off': far-field fast path
+		Solver		solver;				// '--solver newton|halley|schroeder'
+		bool		bench;				// '--bench on': compare all solvers, no image
+		int			threads;			// '--threads': worker threads (0: all hardware threads)
+		bool		cost_schedule;		// '--schedule cost|static'
+		bool		heatmap;			// '--heatmap on': also save the tile cost heatmap
 
 		static void	printUsage(const char* progName);
 
 	private:
+		void	parsePositional(const std::string& arg, int position);
+		void	parseOption(const std::string& option, const std::string& value);
 		bool	isInteger(const std::string& str);
+		bool	isNumber(const std::string& str);
+		bool	parseSwitch(const std::string& option, const std::string& value);
 };
 
 #endif
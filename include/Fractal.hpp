@@ -2,9 +2,59 @@
 # define FRACTAL_HPP
 
 # include "defines.hpp"	// For Color struct, Complex struct
+# include "TileScheduler.hpp"	// For Tile struct
+# include "PixelBuffer.hpp"	// For the image buffer
 # include <vector>
 # include <string>
 # include <utility>	// For std::pair
+# include <atomic>		// For std::atomic (per-tile statistics)
+# include <cstddef>	// For size_t
+
+/**
+ @brief Result of the low-resolution probe pass run by
+ `Fractal::autoTuneIterations()` (what it cost and what it picked).
+*/
+struct ProbeReport
+{
+	int		width;				// Probe image size
+	int		height;
+	int		probe_iterations;	// Iteration budget of the probe itself
+	int		max_iterations;		// Budget picked for the full render
+	double	target_share;		// Requested share of converging pixels
+	double	achieved_share;		// Share reached with 'max_iterations'
+	double	converged_share;	// Share of all probe pixels that converged at all
+	double	elapsed_ms;			// Wall time of the probe
+};
+
+/**
+ @brief Caller-owned output buffers for `Fractal::render()`.
+
+ Buffers are row-major; the stride is the distance between the starts of two
+ rows (bytes for `rgb`, elements for the raw buffers) and may exceed the image
+ width (padding). Leave `rgb` or both raw buffers `nullptr` to skip them.
+*/
+struct RenderTarget
+{
+	unsigned char*	rgb;			// 3 bytes (r, g, b) per pixel
+	size_t			rgb_stride;		// Bytes per row
+	int*			root_indices;	// Converged root per pixel (-1: none)
+	int*			iterations;		// Iterations taken per pixel
+	size_t			raw_stride;		// Elements per row
+};
+
+/**
+ @brief Cost of the last `Fractal::render()` / `Fractal::generate()` call.
+*/
+struct RenderStats
+{
+	double	elapsed_ms;			// Wall time of root finding + coloring
+	double	mean_iterations;	// Iterations per pixel (non-converged count fully)
+	double	converged_share;	// Share of pixels that converged to a root
+	double	coarse_ms;			// Wall time of the coarse cost pass (0.0 if skipped)
+	int		tiles;				// Number of scheduled tiles
+	int		threads;			// Number of worker threads
+	int		nodes;				// Number of NUMA nodes the image was spread over
+};
 
 /**
  @brief Manages the state, generation, and output of a Newton fractal for
@@ -17,17 +67,34 @@
  1. Storing all fractal parameters (n, dimensions, tolerance, viewport).
  2. Pre-calculating the 'n' complex roots for `z^n - 1 = 0`.
  3. Pre-generating a color palette.
- 4. Running the core `solvePixel` logic for every pixel in the image.
- 5. Storing the final image as a vector of `Color` structs.
- 6. Saving the final image data to a c.ppm` file.
+ 4. Running the core `solvePixel` logic (Newton, Halley or Schroeder
+    iteration) for every pixel in the image.
+ 5. Storing the final image as a vector of `Color` structs, or writing
+    colors / raw results into caller-owned buffers (`render()`).
+ 6. Saving the final image data to a `.ppm` file.
 */
 class Fractal
 {
 	public:
 		Fractal(int n, int width, int height);
 
-		void	generate();	// wrapper for generateSeq / generateISPC
-		void	saveImage(const std::string& filename) const;
+		void		generate();	// render() into pixel_data_
+		void		render(const RenderTarget& target);
+		void		saveImage(const std::string& filename) const;
+		void		saveCostHeatmap(const std::string& filename) const;
+
+		void		setTolerance(double tolerance);
+		void		setMaxIterations(int max_iterations);
+		void		setFastPaths(bool enabled);
+		void		setSolver(Solver solver);
+		void		setViewport(double x_min, double x_max, double y_min, double y_max);
+		void		setThreads(int threads);
+		void		setCostScheduling(bool enabled);
+		void		setCostHeatmap(bool enabled);
+		ProbeReport	autoTuneIterations(double target_share);
+
+		const RenderStats&	stats() const;
+		static const char*	solverName(Solver solver);
 
 	private:
 		int		n_orig_;
@@ -36,6 +103,17 @@ class Fractal
 		int		height_;
 		double	tolerance_;
 		int		max_iterations_;
+		Solver	solver_;
+
+		// Far-field fast path (see updateFarField()); radius 0.0 disables it
+		bool	fast_paths_;
+		double	far_field_radius_;
+		double	far_field_shrink_;	// |z| shrink factor per step in the far field
+
+		// Tile scheduling (see TileScheduler)
+		int		threads_;			// 0: one per hardware thread
+		bool	cost_schedule_;		// Coarse-pass cost model vs. static row bands
+		bool	cost_heatmap_;		// Keep tile costs even when single-threaded
 
 		// Viewport boundaries
 		double	x_min_, x_max_, y_min_, y_max_;
@@ -45,17 +123,33 @@ class Fractal
 		std::vector<Color>		palette_;	// The 'n' base colors
 
 		// Final result
-		std::vector<Color>		pixel_data_;	// 1D vector holding the 2D image
+		PixelBuffer<Color>		pixel_data_;	// 1D buffer holding the 2D image
+		RenderStats				stats_;
+		std::vector<Tile>		tiles_;			// Tiles of the last render (with costs)
 
 		void				calculateRoots();
 		void				setupPalette();
+		void				updateFarField();
+		void				copySettings(const Fractal& other);
+		bool				iterationStep(Complex& z);
 		bool				newtonStep(Complex& z);
+		bool				higherOrderStep(Complex& z, double c);
+		int					farFieldJump(Complex& z) const;
 		std::pair<int, int>	solvePixel(Complex z_start, int x, int y);
 		Color				calculateColor(int root_index, int iterations) const;
 
-		// called from wrapper generate()
-		void				generateSeq();
-		void				generateISPC();
+		// called from render(); output pointers refer to the tile's top-left pixel
+		void				estimateTileCosts(TileScheduler& scheduler);
+		void				touchRows(const RenderTarget& target, int y_begin, int y_end) const;
+		void				renderTile(const Tile& tile, const RenderTarget& target,
+										std::atomic<long long>& total_iterations,
+										std::atomic<long long>& converged);
+		void				computeTile(const Tile& tile, int* root_indices,
+										int* iterations, size_t stride);
+		void				generateSeq(const Tile& tile, int* root_indices,
+										int* iterations, size_t stride);
+		void				generateISPC(const Tile& tile, int* root_indices,
+										int* iterations, size_t stride);
 };
 
 #endif
@@ -0,0 +1,23 @@
+#ifndef NUMA_TOPOLOGY_HPP
+# define NUMA_TOPOLOGY_HPP
+
+# include <vector>
+
+/*
+ NUMA node discovery and thread pinning for TileScheduler.
+
+ Linux only (sysfs and pthread affinity); elsewhere the machine is treated
+ as a single node and pinning does nothing.
+*/
+
+// CPUs of each NUMA node that the calling thread may run on.
+// Nodes without such a CPU are left out; fewer than two nodes: empty.
+std::vector<std::vector<int>>	detectNumaNodes();
+
+// CPUs the calling thread may currently run on (empty if unknown)
+std::vector<int>				currentThreadCpus();
+
+// Restricts the calling thread to `cpus`; returns false if that failed
+bool							pinCurrentThread(const std::vector<int>& cpus);
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef PIXEL_BUFFER_HPP
+# define PIXEL_BUFFER_HPP
+
+# include <cstddef>		// For size_t
+# include <type_traits>	// For std::is_trivially_copyable
+# include <utility>		// For std::swap
+
+// Raw allocation behind PixelBuffer (see PixelBuffer.cpp)
+void*	allocatePixelMemory(size_t bytes);
+void	freePixelMemory(void* memory);
+
+/**
+ @brief Fixed-size, uninitialized buffer for per-pixel data.
+
+ Unlike `std::vector`, allocating does not write to the memory:
+  - Memory is aligned to a cache line (`CACHE_LINE_SIZE`), large buffers to
+	a huge page (`HUGE_PAGE_SIZE`) and backed by transparent huge pages.
+  - There is no single-threaded zero-fill pass; pages are mapped when a
+	render first writes them. On NUMA machines, `TileScheduler` has each
+	node's pinned workers touch their own band of rows first, so each page
+	lands on the node that renders it.
+
+ Contents are undefined until written. Move-only.
+*/
+template <typename T>
+class PixelBuffer
+{
+	static_assert(std::is_trivially_copyable<T>::value,
+				"PixelBuffer only holds plain pixel data");
+
+	public:
+		PixelBuffer() : data_(nullptr), size_(0) {}
+		explicit PixelBuffer(size_t count) : data_(nullptr), size_(0) { allocate(count); }
+		~PixelBuffer() { freePixelMemory(data_); }
+
+		PixelBuffer(PixelBuffer&& other) noexcept : data_(other.data_), size_(other.size_)
+		{
+			other.data_ = nullptr;
+			other.size_ = 0;
+		}
+		PixelBuffer&	operator=(PixelBuffer&& other) noexcept
+		{
+			std::swap(data_, other.data_);
+			std::swap(size_, other.size_);
+			return *this;
+		}
+		PixelBuffer(const PixelBuffer&) = delete;
+		PixelBuffer&	operator=(const PixelBuffer&) = delete;
+
+		// (Re)allocates for `count` elements; contents are undefined afterwards.
+		// Keeps the current memory (and its page placement) if the size matches.
+		void	allocate(size_t count)
+		{
+			if (count == size_)
+				return;
+			freePixelMemory(data_);
+			data_ = nullptr;
+			size_ = 0;
+			data_ = static_cast<T*>(allocatePixelMemory(count * sizeof(T)));
+			size_ = count;
+		}
+
+		T*			data() { return data_; }
+		const T*	data() const { return data_; }
+		size_t		size() const { return size_; }
+		bool		empty() const { return size_ == 0; }
+
+		T&			operator[](size_t i) { return data_[i]; }
+		const T&	operator[](size_t i) const { return data_[i]; }
+
+	private:
+		T*		data_;
+		size_t	size_;
+};
+
+#endif
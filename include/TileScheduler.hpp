@@ -0,0 +1,79 @@
+#ifndef TILE_SCHEDULER_HPP
+# define TILE_SCHEDULER_HPP
+
+# include <vector>
+# include <cstddef>		// For size_t
+# include <functional>	// For std::function
+
+/**
+ @brief A rectangular block of pixels handed to one worker at a time.
+*/
+struct Tile
+{
+	int		x;			// Top-left pixel (column)
+	int		y;			// Top-left pixel (row)
+	int		width;
+	int		height;
+	double	cost;		// Estimated cost (sum of iterations); 0.0 if not estimated
+	int		band;		// NUMA band (row range of one node) the tile lies in
+};
+
+/**
+ @brief Splits an image into tiles and runs them on a pool of worker threads.
+
+ With a coarse iteration map (see `setCostMap()`), tiles are given a cost
+ estimate, expensive tiles are split and all tiles are handed out
+ longest-first.
+
+ On machines with several NUMA nodes, the image is first cut into one band
+ of rows per node, at huge-page boundaries of the output buffer (see
+ `setPlacement()`). Each node's workers are pinned to it, first-touch its
+ band's pages and take tiles from its band's queue; they only take tiles
+ from other bands once their own queue is empty.
+*/
+class TileScheduler
+{
+	public:
+		TileScheduler(int width, int height, int threads);
+
+		using TouchFunction = std::function<void(int y_begin, int y_end)>;
+
+		void				setCostMap(const std::vector<int>& iterations,
+										int coarse_width, int coarse_height);
+		void				setPlacement(const void* base, size_t row_bytes);
+
+		std::vector<Tile>	makeStaticTiles();
+		std::vector<Tile>	makeCostTiles();
+		void				run(const std::vector<Tile>& tiles,
+								const std::function<void(const Tile&)>& work,
+								const TouchFunction& touch = nullptr) const;
+		int					threads() const;
+		int					nodes() const;
+		static int			maxThreads();
+
+	private:
+		int					width_;
+		int					height_;
+		int					threads_;
+
+		// Coarse iteration map and the full-image pixel each sample sits on
+		std::vector<int>	cost_map_;
+		int					coarse_width_;
+		std::vector<int>	sample_x_;
+		std::vector<int>	sample_y_;
+
+		// NUMA placement: usable CPUs per node, band cut rows (nodes + 1)
+		std::vector<std::vector<int>>	node_cpus_;
+		std::vector<int>				band_rows_;
+		const unsigned char*			place_base_;	// Output buffer layout
+		size_t							place_row_bytes_;
+
+		double				estimateCost(const Tile& tile) const;
+		void				splitTile(const Tile& tile, double max_cost,
+										std::vector<Tile>& out) const;
+		void				makeBands();
+		int					alignBandRow(int row) const;
+		int					nodeOf(int worker, int workers) const;
+};
+
+#endif
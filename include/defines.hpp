@@ -10,7 +10,7 @@ constexpr double DEF_VIEW_MAX_X =	2.0;	// Default viewport maximum x
 constexpr double DEF_VIEW_MIN_Y =	-2.0;	// Default viewport minimum y
 constexpr double DEF_VIEW_MAX_Y =	2.0;	// Default viewport maximum y
 
-// Max iterations for Newton's method
+// Max iterations for Newton's method (default, override with '--iters')
 // Higher values yield more detail around the edges (color instead of black)
 // but increase computation time
 # define MAX_ITERS					100
@@ -25,14 +25,31 @@ constexpr double GAMMA =			8.0;
 // Distance to root smaller than this is considered converged.
 // Use larger values for faster rendering with less detail
 // especially close to or bigger than 1.0, this gets funky!
+// (default, override with '--tol')
 constexpr double DEF_TOLERANCE =	1e-6;
 
+// Automatic iteration budget ('--iters auto'):
+// A low-resolution probe is rendered first, its iteration histogram is used to
+// pick the smallest max iterations that still lets this share of the probe's
+// converging pixels converge.
+constexpr double AUTO_TARGET_SHARE =	0.995;
+# define AUTO_PROBE_SIZE			128		// Longest side of the probe image (pixels)
+# define AUTO_PROBE_MAX_ITERS		1000	// Iteration budget of the probe itself
+
+// Far-field fast path ('--fast on|off'):
+// Far from the unit circle, Newton's step for z^n - 1 is z * (n-1)/n plus a
+// term of relative size 1 / ((n-1) * |z|^n). Points are only jumped in closed
+// form while that term stays below this bound (double rounding level), so
+// iteration counts and colors stay the same.
+constexpr double FAR_FIELD_REL_ERROR =	1e-16;
+
 // ################################################
 // ################################################
 
 // Use the ISPC struct for Complex numbers
 # include "fractal_ispc.h"
 using Complex = ispc::Complex;
+using Solver = ispc::Solver;	// Newton, Halley or Schroeder iteration
 
 # define OUTPUT_DIR	"out"	// Directory to save output files
 
@@ -41,6 +58,32 @@ using Complex = ispc::Complex;
 
 constexpr double EPSILON =			1e-10; // Check if floating-point number is zero
 
+// Worker threads ('--threads'); 0: one per hardware thread.
+// The sequential build stays single-threaded by default to serve as baseline.
+// At most MAX_THREADS_PER_CPU workers per hardware thread are accepted.
+# ifdef SEQ
+#  define DEF_THREADS		1
+# else
+#  define DEF_THREADS		0
+# endif
+# define MAX_THREADS_PER_CPU	4
+
+// Tile scheduling ('--schedule cost'): a coarse pass estimates per-tile cost
+# define TILE_SIZE			64	// Edge length of a scheduling tile (pixels)
+# define TILE_SPLIT_FACTOR	4	// Split tiles costing more than 1 / (threads * this) of the total
+# define MIN_TILE_SIZE		8	// Never split tiles below this edge length
+# define COARSE_STEP		8	// Coarse pass samples every N-th pixel per axis
+
+// Pixel buffers (see PixelBuffer): uninitialized, aligned, huge pages if large
+# define CACHE_LINE_SIZE	64					// Alignment of every buffer (bytes)
+# define HUGE_PAGE_SIZE		(2 * 1024 * 1024)	// Alignment/THP for larger buffers (bytes)
+
+// NUMA placement (see TileScheduler): on machines with several nodes, each
+// node's workers are pinned to it and first write ("touch") one band of rows,
+// cut at HUGE_PAGE_SIZE boundaries, before rendering it
+# define NUMA_NODE_DIR		"/sys/devices/system/node"	// Linux sysfs node list
+# define PAGE_TOUCH_STEP	4096	// Bytes between first-touch writes (smallest page size)
+
 # define YELLOW		"\033[33m"
 # define RED		"\033[31m"
 # define BOLD		"\033[1m"
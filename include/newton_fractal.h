@@ -0,0 +1,103 @@
+#ifndef NEWTON_FRACTAL_H
+# define NEWTON_FRACTAL_H
+
+/*
+ Embeddable C/C++ API of libnewton_fractal (`make lib`).
+
+ Renders the Newton fractal for `z^n - 1 = 0` straight into caller-owned
+ buffers: no copy of the final image, no file I/O, no printing.
+
+ Example:
+ ```
+ NfParams	params;
+ nfDefaultParams(&params, 5, 1024, 768);
+ params.solver = NF_SOLVER_HALLEY;
+
+ unsigned char*	rgb = malloc(1024 * 3 * 768);
+ NfStatus		status = nfRenderRGB(&params, rgb, 0, NULL);
+ if (status != NF_OK)
+ 	fprintf(stderr, "%s\n", nfStatusString(status));
+ ```
+*/
+
+# include <stddef.h>	// For size_t
+
+# ifdef __cplusplus
+extern "C" {
+# endif
+
+// Iteration scheme (same values as the kernel's Solver enum)
+typedef enum NfSolver
+{
+	NF_SOLVER_NEWTON = 0,
+	NF_SOLVER_HALLEY = 1,
+	NF_SOLVER_SCHROEDER = 2
+} NfSolver;
+
+typedef enum NfStatus
+{
+	NF_OK = 0,
+	NF_ERROR_INVALID_ARGUMENT,	// Bad parameter, buffer or stride
+	NF_ERROR_OUT_OF_MEMORY,
+	NF_ERROR_INTERNAL			// Anything else
+} NfStatus;
+
+// Render parameters; fill with nfDefaultParams() first, then adjust
+typedef struct NfParams
+{
+	int			n;					// Degree of the polynomial (!= 0)
+	int			width;				// Image size in pixels (at least 2 x 2, at most INT_MAX pixels)
+	int			height;
+	double		tolerance;			// Distance to a root counted as converged
+	int			max_iterations;		// 0: pick from a low-resolution probe pass
+	NfSolver	solver;
+	int			fast_paths;			// Non-zero: far-field fast path (same results)
+	int			threads;			// 0: one per hardware thread (at most 4 per hardware thread)
+	int			cost_schedule;		// Non-zero: cost-model tile scheduling
+	double		x_min, x_max;		// Viewport, real axis
+	double		y_min, y_max;		// Viewport, imaginary axis
+} NfParams;
+
+// What a render cost (optional output, pass NULL if not needed)
+typedef struct NfStats
+{
+	double		elapsed_ms;			// Wall time of the render
+	double		mean_iterations;	// Iterations per pixel
+	double		converged_share;	// Share of pixels that converged to a root
+	int			max_iterations;		// Budget used (picked by the probe if requested)
+} NfStats;
+
+/*
+ Fills `params` with the executable's defaults for `z^n - 1` at `width` x `height`.
+*/
+void		nfDefaultParams(NfParams* params, int n, int width, int height);
+
+/*
+ Renders colors into `rgb`: 3 bytes (r, g, b) per pixel, row-major.
+ `row_stride` is the number of bytes between the starts of two rows
+ (0: tightly packed, `width * 3`); `rgb` must hold `height` rows of it.
+*/
+NfStatus	nfRenderRGB(const NfParams* params, unsigned char* rgb, size_t row_stride,
+						NfStats* stats);
+
+/*
+ Renders raw results: the index of the root each pixel converged to
+ (-1: none) and the iterations it took, row-major.
+ `row_stride` is the number of elements between the starts of two rows
+ (0: tightly packed, `width`); both buffers must hold `height` rows of it.
+ The offset of the last pixel, `(height - 1) * row_stride + width`, must fit
+ in an `int` (NF_ERROR_INVALID_ARGUMENT otherwise).
+*/
+NfStatus	nfRenderRaw(const NfParams* params, int* root_indices, int* iterations,
+						size_t row_stride, NfStats* stats);
+
+/*
+ Returns a short, static description of `status`.
+*/
+const char*	nfStatusString(NfStatus status);
+
+# ifdef __cplusplus
+}
+# endif
+
+#endif
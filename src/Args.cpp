@@ -1,70 +1,195 @@
 #include "Args.hpp"
 #include "defines.hpp"	// color codes
+#include "TileScheduler.hpp"	// For TileScheduler::maxThreads
 
 #include <iostream>
 #include <stdexcept>	// For std::invalid_argument
 #include <cctype>		// For std::isdigit
-#include <string>		// For std::stoi
-#include <cmath>		// For std::abs
+#include <string>		// For std::stoi, std::stod
+#include <cmath>		// For std::abs, std::isfinite
 
 // Constructor takes command-line arguments and initializes member variables.	
 Args::Args(int argc, char** argv)
-	: n_orig(0), width(DEF_WIDTH), height(DEF_HEIGHT)
+	: n_orig(0), width(DEF_WIDTH), height(DEF_HEIGHT),
+	tolerance(DEF_TOLERANCE), max_iterations(MAX_ITERS), auto_iterations(false), fast_paths(true),
+	solver(ispc::SOLVER_NEWTON), bench(false),
+	threads(DEF_THREADS), cost_schedule(true), heatmap(false)
 {
+	int	position = 0; // Number of positional arguments seen so far
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string	arg = argv[i];
+
+		// Options are '--name value' pairs; anything else is positional
+		if (arg.compare(0, 2, "--") == 0)
+		{
+			if (i + 1 >= argc)
+				throw std::invalid_argument("Error: Missing value for option '" + arg + "'");
+			parseOption(arg, argv[++i]);
+		}
+		else
+			parsePositional(arg, position++);
+	}
+
 	// Check 'n'
-	if (argc < 2)
+	if (position < 1)
 		throw std::invalid_argument("Error: Missing required argument <n>");
 
-	if (!isInteger(argv[1]))
-		throw std::invalid_argument("Error: <n> must be a valid integer");
+	// The heatmap shows the cost model's estimates, so it needs the cost pass
+	if (heatmap && !cost_schedule)
+		throw std::invalid_argument("Error: --heatmap on requires --schedule cost");
+	if (heatmap && bench)
+		throw std::invalid_argument("Error: --heatmap on cannot be combined with --bench on (no image is saved)");
+}
 
-	n_orig = std::stoi(argv[1]);
-	int	n = std::abs(n_orig); // Use absolute value of n, as z^-n = 1 is same as z^n = 1
-	if (n == 0)
-		throw std::invalid_argument("Error: <n> must not be 0. No derivative exists.");
+// Prints usage information
+void	Args::printUsage(const char* progName)
+{
+	// Errors can happen after a render whose statistics set 'fixed' formatting
+	std::cout.flags(std::ios::fmtflags());
+	std::cout.precision(6);
+
+	std::cout	<< BOLD << YELLOW << "Usage: " << progName << " <n> [width] [height] [options]" << RESET << std::endl;
+	std::cout	<< "  <n>      : Degree of the polynomial (integer != 0)" << std::endl;
+	std::cout	<< "  [width]  : Width of the output image (optional, integer >= 2, default: "
+				<< DEF_WIDTH << ")" << std::endl;
+	std::cout	<< "  [height] : Height of the output image (optional, integer >= 2, default: "
+				<< DEF_HEIGHT << ")" << std::endl;
+	std::cout	<< "Options:" << std::endl;
+	std::cout	<< "  --tol <value>          : Convergence tolerance (positive number, default: "
+				<< DEF_TOLERANCE << ")" << std::endl;
+	std::cout	<< "  --iters <value|auto>   : Max iterations (positive integer, default: "
+				<< MAX_ITERS << ")" << std::endl;
+	std::cout	<< "                           'auto' picks the budget from a low-resolution probe" << std::endl;
+	std::cout	<< "  --fast <on|off>        : Far-field fast path (default: on; same results)" << std::endl;
+	std::cout	<< "  --solver <name>        : Iteration scheme: newton, halley or schroeder (default: newton)" << std::endl;
+	std::cout	<< "  --bench <on|off>       : Render with every solver and compare them (no image saved)" << std::endl;
+	std::cout	<< "  --threads <value>      : Worker threads (0: one per hardware thread, at most "
+				<< MAX_THREADS_PER_CPU << " per hardware thread, default: " << DEF_THREADS << ")" << std::endl;
+	std::cout	<< "  --schedule <cost|static> : Tile scheduling from a coarse cost pass, or one row band"
+				<< " per thread (default: cost)" << std::endl;
+	std::cout	<< "  --heatmap <on|off>     : Also save the estimated tile costs as '<image>_cost.ppm'"
+				<< " (needs '--schedule cost', not with '--bench')" << std::endl;
+}
 
-	if (n < 3) // OK but boring (no fractals)
+/**
+ @brief Parses the positional argument at `position` (0: n, 1: width, 2: height).
+*/
+void	Args::parsePositional(const std::string& arg, int position)
+{
+	if (position == 0)
 	{
-		std::cerr	<< YELLOW << BOLD << "Warning: Low degree polynomial (n="
-					<< n_orig << ")." << RESET <<std::endl;
-		std::cerr	<< YELLOW << "         Results will be non-fractal (straight lines/monochrome). Use |n| >= 3 for chaos."
-					<< RESET << std::endl;
-	}
+		if (!isInteger(arg))
+			throw std::invalid_argument("Error: <n> must be a valid integer");
+
+		n_orig = std::stoi(arg);
+		int	n = std::abs(n_orig); // Use absolute value of n, as z^-n = 1 is same as z^n = 1
+		if (n == 0)
+			throw std::invalid_argument("Error: <n> must not be 0. No derivative exists.");
 
+		if (n < 3) // OK but boring (no fractals)
+		{
+			std::cerr	<< YELLOW << BOLD << "Warning: Low degree polynomial (n="
+						<< n_orig << ")." << RESET <<std::endl;
+			std::cerr	<< YELLOW << "         Results will be non-fractal (straight lines/monochrome). Use |n| >= 3 for chaos."
+						<< RESET << std::endl;
+		}
+	}
 	// Check for optional 'width'
-	if (argc >= 3)
+	else if (position == 1)
 	{
-		if (!isInteger(argv[2]))
+		if (!isInteger(arg))
 			throw std::invalid_argument("Error: [width] must be a valid integer");
-		width = std::stoi(argv[2]);
-		if (width <= 0)
-			throw std::invalid_argument("Error: [width] must be a positive integer");
+		width = std::stoi(arg);
+		if (width < 2)
+			throw std::invalid_argument("Error: [width] must be an integer >= 2");
 	}
-
 	// Check for optional 'height'
-	if (argc >= 4)
+	else if (position == 2)
 	{
-		if (!isInteger(argv[3]))
-		{
+		if (!isInteger(arg))
 			throw std::invalid_argument("Error: [height] must be a valid integer");
-		}
-		height = std::stoi(argv[3]);
-		if (height <= 0)
+		height = std::stoi(arg);
+		if (height < 2)
+			throw std::invalid_argument("Error: [height] must be an integer >= 2");
+	}
+	else
+		throw std::invalid_argument("Error: Unexpected argument '" + arg + "'");
+}
+
+/**
+ @brief Parses a single `--option value` pair.
+*/
+void	Args::parseOption(const std::string& option, const std::string& value)
+{
+	if (option == "--tol")
+	{
+		if (!isNumber(value) || std::stod(value) <= 0.0)
+			throw std::invalid_argument("Error: --tol must be a positive number");
+		tolerance = std::stod(value);
+	}
+	else if (option == "--iters")
+	{
+		if (value == "auto")
 		{
-			throw std::invalid_argument("Error: [height] must be a positive integer");
+			auto_iterations = true;
+			return;
 		}
+		if (!isInteger(value) || std::stoi(value) <= 0)
+			throw std::invalid_argument("Error: --iters must be a positive integer or 'auto'");
+		max_iterations = std::stoi(value);
+		auto_iterations = false;
+	}
+	else if (option == "--fast")
+		fast_paths = parseSwitch(option, value);
+	else if (option == "--solver")
+	{
+		if (value == "newton")
+			solver = ispc::SOLVER_NEWTON;
+		else if (value == "halley")
+			solver = ispc::SOLVER_HALLEY;
+		else if (value == "schroeder")
+			solver = ispc::SOLVER_SCHROEDER;
+		else
+			throw std::invalid_argument("Error: --solver must be 'newton', 'halley' or 'schroeder'");
+	}
+	else if (option == "--bench")
+		bench = parseSwitch(option, value);
+	else if (option == "--threads")
+	{
+		if (!isInteger(value) || value.size() > 9 || std::stoi(value) < 0)
+			throw std::invalid_argument("Error: --threads must be a non-negative integer");
+		threads = std::stoi(value);
+		if (threads > TileScheduler::maxThreads())
+			throw std::invalid_argument("Error: --threads must not exceed "
+				+ std::to_string(TileScheduler::maxThreads()) + " (" + std::to_string(MAX_THREADS_PER_CPU)
+				+ " per hardware thread)");
+	}
+	else if (option == "--schedule")
+	{
+		if (value != "cost" && value != "static")
+			throw std::invalid_argument("Error: --schedule must be 'cost' or 'static'");
+		cost_schedule = (value == "cost");
 	}
+	else if (option == "--heatmap")
+		heatmap = parseSwitch(option, value);
+	else
+		throw std::invalid_argument("Error: Unknown option '" + option + "'");
 }
 
-// Prints usage information
-void	Args::printUsage(const char* progName)
+/**
+ @brief Parses the value of an on/off option.
+
+ @return	`true` for "on", `false` for "off".
+*/
+bool	Args::parseSwitch(const std::string& option, const std::string& value)
 {
-	std::cout	<< BOLD << YELLOW << "Usage: " << progName << " <n> [width] [height]" << RESET << std::endl;
-	std::cout	<< "  <n>      : Degree of the polynomial (integer != 0)" << std::endl;
-	std::cout	<< "  [width]  : Width of the output image (optional, positive integer, default: "
-				<< DEF_WIDTH << ")" << std::endl;
-	std::cout	<< "  [height] : Height of the output image (optional, positive integer, default: "
-				<< DEF_HEIGHT << ")" << std::endl;
+	if (value == "on")
+		return true;
+	if (value == "off")
+		return false;
+	throw std::invalid_argument("Error: " + option + " must be 'on' or 'off'");
 }
 
 /**
@@ -82,6 +207,9 @@ bool	Args::isInteger(const std::string& str)
 	if (str[0] == '-' || str[0] == '+')
 		start = 1;
 
+	if (start == str.length())
+		return false;
+
 	for (size_t i = start; i < str.length(); ++i)
 	{
 		if (!std::isdigit(str[i]))
@@ -89,3 +217,26 @@ bool	Args::isInteger(const std::string& str)
 	}
 	return true;
 }
+
+/**
+ @brief Checks if a string contains only a valid, finite floating-point number
+ (e.g. `0.001`, `1e-6`).
+
+ Does NOT allow whitespace or any trailing characters.
+*/
+bool	Args::isNumber(const std::string& str)
+{
+	if (str.empty() || std::isspace(static_cast<unsigned char>(str[0])))
+		return false;
+
+	try
+	{
+		size_t	parsed = 0;
+		double	value = std::stod(str, &parsed);
+		return parsed == str.length() && std::isfinite(value);
+	}
+	catch (const std::exception&)
+	{
+		return false;
+	}
+}
@@ -7,7 +7,15 @@
 #include <cmath>		// For std::abs, M_PI, cos, sin, std::pow (brightness calculation)
 #include <iomanip>		// Formatte output debug prints
 #include <fstream>		// For file output
-#include <stdexcept>	// For std::runtime_error
+#include <stdexcept>	// For std::runtime_error, std::invalid_argument
+#include <algorithm>	// For std::min, std::max
+#include <chrono>		// For timing the probe pass
+#include <limits>		// For std::numeric_limits (kernel index range)
+#include <cstdint>		// For uintptr_t (page touching)
+
+static void	writePPM(const std::string& filename, int width, int height,
+						const Color* pixels);
+static void	touchPages(void* begin, size_t bytes);
 
 /**
  @brief Constructor for the Fractal.
@@ -18,13 +26,24 @@
 */
 Fractal::Fractal(int n_orig, int width, int height) :
 	n_orig_(n_orig), n_(std::abs(n_orig)), width_(width), height_(height),
-	tolerance_(DEF_TOLERANCE), max_iterations_(MAX_ITERS),
+	tolerance_(DEF_TOLERANCE), max_iterations_(MAX_ITERS), solver_(ispc::SOLVER_NEWTON),
+	fast_paths_(true), far_field_radius_(0.0), far_field_shrink_(0.0),
+	threads_(DEF_THREADS), cost_schedule_(true), cost_heatmap_(false),
 	x_min_(DEF_VIEW_MIN_X), x_max_(DEF_VIEW_MAX_X),
-	y_min_(DEF_VIEW_MIN_Y), y_max_(DEF_VIEW_MAX_Y)
+	y_min_(DEF_VIEW_MIN_Y), y_max_(DEF_VIEW_MAX_Y), stats_()
 {
+	if (n_ == 0)
+		throw std::invalid_argument("Error: n must not be 0. No derivative exists.");
+	// The pixel -> plane mapping divides by (width - 1) and (height - 1)
+	if (width_ < 2 || height_ < 2)
+		throw std::invalid_argument("Error: Image size must be at least 2 x 2 pixels.");
+	// The ISPC kernel indexes pixels with 'int'
+	if (static_cast<size_t>(width_) * height_ > static_cast<size_t>(std::numeric_limits<int>::max()))
+		throw std::invalid_argument("Error: Image has too many pixels.");
+
 	calculateRoots();
 	setupPalette();
-	pixel_data_.resize(width_ * height_); // Allocate space for pixel data
+	updateFarField();
 
 	DEBUG_PRINT("--- Fractal Object Created ---");
 	DEBUG_PRINT("  image size: " << width_ << " x " << height_);
@@ -42,41 +61,261 @@ Fractal::Fractal(int n_orig, int width, int height) :
 /**
  @brief Generates the Newton fractal for all pixels in the image.
 
- This function serves as a wrapper that chooses the appropriate
- generation method based on compilation flags:
+ Renders the colors straight into the `pixel_data_` buffer (see `render()`).
+ The buffer is not cleared beforehand (see `PixelBuffer`).
+ Timing and iteration statistics are kept in `stats_` (see `stats()`).
+*/
+void	Fractal::generate()
+{
+	static_assert(sizeof(Color) == 3, "Color must be tightly packed RGB");
+
+	pixel_data_.allocate(static_cast<size_t>(width_) * height_); // Uninitialized
+
+	RenderTarget	target = {};
+	target.rgb = reinterpret_cast<unsigned char*>(pixel_data_.data());
+	target.rgb_stride = width_ * sizeof(Color);
+	render(target);
+}
+
+/**
+ @brief Renders the fractal into caller-owned buffers (no copy, no I/O).
+
+ The image is split into tiles which are computed by `threads_` workers
+ (see `TileScheduler`):
+  - Cost scheduling (`cost_schedule_`, default): a coarse pass estimates the
+	cost of each tile (`estimateTileCosts()`); expensive tiles are split and
+	all tiles are handed out longest-first.
+  - Static scheduling: one equal-height row band per worker.
+
+ On NUMA machines, each node's workers first touch their band of the
+ output buffers (`touchRows()`), so its pages live in that node's memory.
+ Each tile is written to `target` by `renderTile()`.
+ Timing and iteration statistics are kept in `stats_` (see `stats()`).
+
+ @param target	Output buffers; each must hold `height_` rows of its stride.
+*/
+void	Fractal::render(const RenderTarget& target)
+{
+	bool	raw = (target.root_indices != nullptr && target.iterations != nullptr);
+	if (target.rgb == nullptr && !raw)
+		throw std::invalid_argument("Error: Render target has no output buffer.");
+	if (target.rgb != nullptr && target.rgb_stride < static_cast<size_t>(width_) * 3)
+		throw std::invalid_argument("Error: RGB row stride is smaller than the image width.");
+	if (raw && target.raw_stride < static_cast<size_t>(width_))
+		throw std::invalid_argument("Error: Raw row stride is smaller than the image width.");
+
+	// Raw buffers are written by the kernel with 'int' offsets (row * stride + col);
+	// the last pixel must be reachable without overflow
+	const size_t	max_index = static_cast<size_t>(std::numeric_limits<int>::max());
+	if (raw && (target.raw_stride > max_index
+				|| (height_ - 1) * target.raw_stride + width_ > max_index))
+		throw std::invalid_argument("Error: Raw row stride is too large for the kernel's int indexing.");
+
+	auto	start = std::chrono::steady_clock::now();
+
+	TileScheduler	scheduler(width_, height_, threads_);
+	if (target.rgb != nullptr)
+		scheduler.setPlacement(target.rgb, target.rgb_stride);
+	else
+		scheduler.setPlacement(target.iterations, target.raw_stride * sizeof(int));
+
+	// A single worker gains nothing from ordering; only pay for the coarse pass
+	// if it helps balancing or its heatmap was asked for
+	stats_.coarse_ms = 0.0;
+	if (cost_schedule_ && (scheduler.threads() > 1 || cost_heatmap_))
+		estimateTileCosts(scheduler);
+
+	tiles_ = cost_schedule_ ? scheduler.makeCostTiles() : scheduler.makeStaticTiles();
+	stats_.tiles = static_cast<int>(tiles_.size());
+	stats_.threads = scheduler.threads();
+	stats_.nodes = scheduler.nodes();
+
+	DEBUG_PRINT("--- Tile Scheduling ---");
+	DEBUG_PRINT("  " << tiles_.size() << " tiles on " << scheduler.threads() << " threads\n");
+
+	std::atomic<long long>	total_iterations(0);
+	std::atomic<long long>	converged(0);
+	scheduler.run(tiles_, [&](const Tile& tile)
+	{
+		renderTile(tile, target, total_iterations, converged);
+	},
+	[&](int y_begin, int y_end)
+	{
+		touchRows(target, y_begin, y_end);
+	});
+
+	auto	end = std::chrono::steady_clock::now();
+	double	pixels = static_cast<double>(width_) * height_;
+	stats_.elapsed_ms = std::chrono::duration<double, std::milli>(end - start).count();
+	stats_.mean_iterations = total_iterations / pixels;
+	stats_.converged_share = converged / pixels;
+}
+
+/**
+ @brief Returns timing and iteration statistics of the last `render()` call.
+*/
+const RenderStats&	Fractal::stats() const
+{
+	return stats_;
+}
+
+/**
+ @brief Computes one tile and writes it to `target`.
+
+ Raw results go straight into the caller's buffers. For RGB-only targets the
+ results go to a tile-sized scratch buffer (small enough to stay in cache)
+ instead, so no full-size intermediate buffer is needed. Colors are then
+ computed with `calculateColor()` and written to the caller's rows.
+*/
+void	Fractal::renderTile(const Tile& tile, const RenderTarget& target,
+							std::atomic<long long>& total_iterations,
+							std::atomic<long long>& converged)
+{
+	PixelBuffer<int>	scratch;
+	int*				root_indices;
+	int*				iterations;
+	size_t				stride;
+
+	if (target.root_indices != nullptr && target.iterations != nullptr)
+	{
+		size_t	offset = static_cast<size_t>(tile.y) * target.raw_stride + tile.x;
+		root_indices = target.root_indices + offset;
+		iterations = target.iterations + offset;
+		stride = target.raw_stride;
+	}
+	else
+	{
+		scratch.allocate(2 * static_cast<size_t>(tile.width) * tile.height);
+		root_indices = scratch.data();
+		iterations = scratch.data() + static_cast<size_t>(tile.width) * tile.height;
+		stride = tile.width;
+	}
+
+	computeTile(tile, root_indices, iterations, stride);
+
+	long long	tile_iterations = 0;
+	long long	tile_converged = 0;
+	for (int row = 0; row < tile.height; ++row)
+	{
+		for (int col = 0; col < tile.width; ++col)
+		{
+			int	root_index = root_indices[row * stride + col];
+			int	iteration_count = iterations[row * stride + col];
+			tile_iterations += iteration_count;
+			tile_converged += (root_index != -1);
+
+			if (target.rgb == nullptr)
+				continue;
+
+			// Convert result to color, store in the caller's row
+			Color			color = calculateColor(root_index, iteration_count);
+			int				x = tile.x + col;
+			int				y = tile.y + row;
+			unsigned char*	pixel = target.rgb + static_cast<size_t>(y) * target.rgb_stride
+									+ static_cast<size_t>(x) * 3;
+			pixel[0] = color.r;
+			pixel[1] = color.g;
+			pixel[2] = color.b;
+
+			// Debug logging for some pixels
+			if (x % DEBUG_PIXEL_INTERVAL == 0 && y % DEBUG_PIXEL_INTERVAL == 0)
+			{
+				DEBUG_PRINT("  Color (" << x << ", " << y << "): ("
+							<< static_cast<int>(color.r) << ", "
+							<< static_cast<int>(color.g) << ", "
+							<< static_cast<int>(color.b) << ")");
+			}
+		}
+	}
+
+	total_iterations += tile_iterations;
+	converged += tile_converged;
+}
+
+/**
+ @brief Writes one byte per page of rows `[y_begin, y_end)` of every buffer
+ in `target` (only inside the image, never in row padding).
+
+ Called by the worker owning those rows before any tile is rendered: the
+ first write maps a page on the writing thread's NUMA node. The bytes are
+ overwritten by the render.
+*/
+void	Fractal::touchRows(const RenderTarget& target, int y_begin, int y_end) const
+{
+	bool	raw = (target.root_indices != nullptr && target.iterations != nullptr);
+	for (int y = y_begin; y < y_end; ++y)
+	{
+		if (target.rgb != nullptr)
+			touchPages(target.rgb + static_cast<size_t>(y) * target.rgb_stride,
+						static_cast<size_t>(width_) * 3);
+		if (raw)
+		{
+			size_t	offset = static_cast<size_t>(y) * target.raw_stride;
+			touchPages(target.root_indices + offset, width_ * sizeof(int));
+			touchPages(target.iterations + offset, width_ * sizeof(int));
+		}
+	}
+}
+
+/**
+ @brief Renders a coarse pass (every `COARSE_STEP`-th pixel per axis, same
+ settings) and hands its iteration counts to `scheduler` as cost map.
+*/
+void	Fractal::estimateTileCosts(TileScheduler& scheduler)
+{
+	auto	start = std::chrono::steady_clock::now();
+
+	int		coarse_width = std::max(2, (width_ + COARSE_STEP - 1) / COARSE_STEP);
+	int		coarse_height = std::max(2, (height_ + COARSE_STEP - 1) / COARSE_STEP);
+
+	Fractal	coarse(n_orig_, coarse_width, coarse_height);
+	coarse.copySettings(*this);
+	coarse.cost_schedule_ = false; // No cost model for the cost model
+
+	std::vector<int>	root_indices(coarse_width * coarse_height);
+	std::vector<int>	iterations(coarse_width * coarse_height);
+	coarse.render({nullptr, 0, root_indices.data(), iterations.data(),
+					static_cast<size_t>(coarse_width)});
+	scheduler.setCostMap(iterations, coarse_width, coarse_height);
+
+	auto	end = std::chrono::steady_clock::now();
+	stats_.coarse_ms = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/**
+ @brief Computes one tile with the backend chosen by compilation flags:
   - If compiled with `-DSEQ` (`make seq`), it runs the sequential CPU version (`generateSeq()`).
   - Otherwise, it runs the ISPC parallel version (`generateISPC()`).
 
- The function handles mapping each pixel to a complex number, computing
- its convergence using Newton's method, and storing the final colors
- in the `pixel_data_` vector.
+ @param root_indices	Output for the tile's top-left pixel (-1: no convergence).
+ @param iterations		Output for the tile's top-left pixel (iterations taken).
+ @param stride			Elements between the starts of two output rows.
 */
-void	Fractal::generate()
+void	Fractal::computeTile(const Tile& tile, int* root_indices, int* iterations, size_t stride)
 {
 #ifdef SEQ
-	generateSeq();	// sequential CPU version
+	generateSeq(tile, root_indices, iterations, stride);	// sequential CPU version
 #else
-	generateISPC();	// ISPC parallel version
+	generateISPC(tile, root_indices, iterations, stride);	// ISPC parallel version
 #endif
 }
 
 /**
  @brief Runs the main fractal generation loop on the CPU sequentially.
 
- This function iterates over every `(x, y)` pixel in the image, 
- maps each pixel to a complex number (`z_start`) within the viewport,
- calls `solvePixel()` to determine the root and iteration count,
- then uses `calculateColor()` to determine the final color.
- The resulting color is stored in the 1D `pixel_data_` vector.
+ This function iterates over every `(x, y)` pixel in the tile, 
+ maps each pixel to a complex number (`z_start`) within the viewport
+ and calls `solvePixel()` to determine the root and iteration count.
+ The results are stored in the `root_indices` / `iterations` buffers.
 
- This is the sequential (single-threaded) version.
+ This is the sequential (non-SIMD) version.
 */
-void	Fractal::generateSeq()
+void	Fractal::generateSeq(const Tile& tile, int* root_indices, int* iterations, size_t stride)
 {
-	// Main loop: Iterate over each every row
-	for (int y = 0; y < height_; ++y)
+	// Main loop: Iterate over each every row of the tile
+	for (int y = tile.y; y < tile.y + tile.height; ++y)
 	{
-		for (int x = 0; x < width_; ++x)
+		for (int x = tile.x; x < tile.x + tile.width; ++x)
 		{
 			// -- MAP --
 			// Convert the pixel (x, y) to a complex number z_start within the viewport
@@ -92,58 +331,248 @@ void	Fractal::generateSeq()
 			// -- SOLVE --
 			std::pair<int, int>	solution = solvePixel(z_start, x, y);
 
-			// -- COLOR --
-			Color	pixel_color = calculateColor(solution.first, solution.second);
+			// --- STORE --- Save results relative to the tile's top-left pixel
+			size_t	index = (y - tile.y) * stride + (x - tile.x);
+			root_indices[index] = solution.first;
+			iterations[index] = solution.second;
+		}
+	}
+}
 
-			// Debug logging for some pixels
-			if (x % DEBUG_PIXEL_INTERVAL == 0 && y % DEBUG_PIXEL_INTERVAL == 0)
-			{
-				DEBUG_PRINT("  Color: ("
-							<< static_cast<int>(pixel_color.r) << ", "
-							<< static_cast<int>(pixel_color.g) << ", "
-							<< static_cast<int>(pixel_color.b) << ")\n");
-			}
+/**
+ @brief Generate one tile of the Newton fractal using the ISPC parallel kernel.
 
-			// --- STORE --- Save color in 1D pixel vector
-			pixel_data_[y * width_ + x] = pixel_color;
-		}
+ This function calls the ISPC `calculateFractal` kernel to compute the
+ tile in parallel, writing straight to the given output buffers
+ (ISPC requires C-style arrays).
+*/
+void	Fractal::generateISPC(const Tile& tile, int* root_indices, int* iterations, size_t stride)
+{
+	// This call populates the tile's pixels in 'root_indices' and 'iterations'
+	ispc::calculateFractal(
+		width_, height_, tile.x, tile.y, tile.width, tile.height,
+		n_, roots_.data(), solver_, tolerance_, EPSILON, max_iterations_,
+		far_field_radius_, far_field_shrink_,
+		x_min_, x_max_, y_min_, y_max_,
+		root_indices, iterations, static_cast<int>(stride) // Range checked in render()
+	);
+}
+
+/////////////////////
+// TILE SCHEDULING //
+/////////////////////
+
+/**
+ @brief Sets the number of worker threads (0: one per hardware thread,
+ at most `TileScheduler::maxThreads()`).
+*/
+void	Fractal::setThreads(int threads)
+{
+	if (threads < 0)
+		throw std::invalid_argument("Error: Thread count must not be negative.");
+	if (threads > TileScheduler::maxThreads())
+		throw std::invalid_argument("Error: Thread count exceeds "
+			+ std::to_string(TileScheduler::maxThreads()) + " (MAX_THREADS_PER_CPU per hardware thread).");
+	threads_ = threads;
+}
+
+/**
+ @brief Chooses between cost-model tile scheduling (`true`) and static
+ row bands, one per worker (`false`).
+*/
+void	Fractal::setCostScheduling(bool enabled)
+{
+	cost_schedule_ = enabled;
+}
+
+/**
+ @brief Runs the coarse cost pass even on a single thread, so that
+ `saveCostHeatmap()` has something to show.
+*/
+void	Fractal::setCostHeatmap(bool enabled)
+{
+	cost_heatmap_ = enabled;
+}
+
+/**
+ @brief Copies all render settings except the image size from `other`
+ (used for the probe and coarse passes).
+*/
+void	Fractal::copySettings(const Fractal& other)
+{
+	tolerance_ = other.tolerance_;
+	max_iterations_ = other.max_iterations_;
+	solver_ = other.solver_;
+	fast_paths_ = other.fast_paths_;
+	threads_ = other.threads_;
+	cost_schedule_ = other.cost_schedule_;
+	x_min_ = other.x_min_;
+	x_max_ = other.x_max_;
+	y_min_ = other.y_min_;
+	y_max_ = other.y_max_;
+	updateFarField();
+}
+
+//////////////////////
+// ITERATION BUDGET //
+//////////////////////
+
+/**
+ @brief Sets the convergence tolerance (distance to a root counted as converged).
+*/
+void	Fractal::setTolerance(double tolerance)
+{
+	if (!(tolerance > 0.0))
+		throw std::invalid_argument("Error: Tolerance must be positive.");
+	tolerance_ = tolerance;
+	updateFarField(); // Far-field radius depends on the tolerance
+}
+
+/**
+ @brief Sets the maximum number of Newton iterations per pixel.
+*/
+void	Fractal::setMaxIterations(int max_iterations)
+{
+	if (max_iterations <= 0)
+		throw std::invalid_argument("Error: Max iterations must be positive.");
+	max_iterations_ = max_iterations;
+}
+
+/**
+ @brief Enables or disables the far-field fast path (see `updateFarField()`).
+ Results are the same either way; this allows comparing against the plain path.
+*/
+void	Fractal::setFastPaths(bool enabled)
+{
+	fast_paths_ = enabled;
+	updateFarField();
+}
+
+/**
+ @brief Selects the iteration scheme (Newton, Halley or Schroeder).
+*/
+void	Fractal::setSolver(Solver solver)
+{
+	solver_ = solver;
+	updateFarField(); // Far-field behavior depends on the solver
+}
+
+/**
+ @brief Sets the area of the complex plane to render
+ (x: real part, y: imaginary part).
+*/
+void	Fractal::setViewport(double x_min, double x_max, double y_min, double y_max)
+{
+	if (!(x_min < x_max) || !(y_min < y_max))
+		throw std::invalid_argument("Error: Viewport minimum must be smaller than maximum.");
+	x_min_ = x_min;
+	x_max_ = x_max;
+	y_min_ = y_min;
+	y_max_ = y_max;
+}
+
+/**
+ @brief Returns the lowercase name of `solver` (as accepted by `--solver`).
+*/
+const char*	Fractal::solverName(Solver solver)
+{
+	switch (solver)
+	{
+		case ispc::SOLVER_HALLEY:		return "halley";
+		case ispc::SOLVER_SCHROEDER:	return "schroeder";
+		default:						return "newton";
 	}
 }
 
 /**
- @brief Generate the Newton fractal using the ISPC parallel kernel.
+ @brief Picks `max_iterations_` from a fast, low-resolution probe render.
 
- This function sets up the necessary buffers for ISPC, calls the ISPC
- `calculateFractal` kernel to compute the fractal in parallel, and
- stores the resulting pixel colors in `pixel_data_`.
+ The probe renders the same viewport (same backend, same tolerance) at most
+ `AUTO_PROBE_SIZE` pixels along its longest side with a generous budget of
+ `AUTO_PROBE_MAX_ITERS`, and builds the histogram of iterations taken by
+ converging pixels. The new budget is the smallest one that lets
+ `target_share` of those pixels converge. Pixels that never converge in the
+ probe (basin boundaries, the origin) cannot be fixed by more iterations
+ and are therefore not part of the target.
 
- Steps performed:
- 1.	Allocate temporary integer vectors (`root_indices` and `iterations`)
-	to hold the results for each pixel.
- 2.	Call the ISPC kernel `calculateFractal`, using pointers to the output arrays
-	(`.data()` is used to get raw pointers from the vectors,
-	because ISPC requires C-style arrays).
- 3.	Convert the integer results from ISPC into `Color` objects for each pixel,
-	storing them in `pixel_data_` for later saving to an image file.
+ A pixel that converged after `k` iterations needs a budget of `k + 1`,
+ as the convergence check runs at the start of each iteration.
+
+ @param target_share	Share of converging pixels to keep, in `(0, 1]`.
+ @return				What the probe cost and which budget it picked.
 */
-void	Fractal::generateISPC()
+ProbeReport	Fractal::autoTuneIterations(double target_share)
 {
-	// Allocate output buffers for ISPC lanes
-	std::vector<int>	root_indices(width_ * height_);
-	std::vector<int>	iterations(width_ * height_);
+	if (!(target_share > 0.0 && target_share <= 1.0))
+		throw std::invalid_argument("Error: Target share must be in (0, 1].");
 
-	// Call ISPC kernel; use .data() to get raw pointer to vector memory
-	// This call populates 'root_indices' and 'iterations' with all pixel results
-	ispc::calculateFractal(
-		width_, height_, n_, roots_.data(), tolerance_, EPSILON, max_iterations_,
-		x_min_, x_max_, y_min_, y_max_, root_indices.data(), iterations.data()
-	);
+	auto	start = std::chrono::steady_clock::now();
+
+	// Keep aspect ratio; at least 2 pixels per side for the viewport mapping
+	int		longest = std::max(width_, height_);
+	double	scale = std::min(1.0, static_cast<double>(AUTO_PROBE_SIZE) / longest);
+	int		probe_width = std::max(2, static_cast<int>(width_ * scale));
+	int		probe_height = std::max(2, static_cast<int>(height_ * scale));
+
+	Fractal	probe(n_orig_, probe_width, probe_height);
+	probe.copySettings(*this);
+	probe.max_iterations_ = AUTO_PROBE_MAX_ITERS;
+	probe.cost_schedule_ = false; // Too small to be worth a cost model
 
-	// Convert results to Color vector
-	for (int i = 0; i < width_ * height_; ++i)
+	int					total = probe_width * probe_height;
+	std::vector<int>	root_indices(total);
+	std::vector<int>	iterations(total);
+	probe.render({nullptr, 0, root_indices.data(), iterations.data(),
+					static_cast<size_t>(probe_width)});
+
+	// Histogram of iterations taken by converging pixels
+	std::vector<int>	histogram(AUTO_PROBE_MAX_ITERS + 1, 0);
+	int					converged = 0;
+	for (int i = 0; i < total; ++i)
 	{
-		pixel_data_[i] = calculateColor(root_indices[i], iterations[i]);
+		if (root_indices[i] != -1)
+		{
+			++histogram[iterations[i]];
+			++converged;
+		}
 	}
+
+	// Smallest budget whose cumulative count reaches the target
+	int	budget = 1;
+	int	covered = 0;
+	if (converged > 0)
+	{
+		double	needed = target_share * converged;
+		for (int k = 0; k <= AUTO_PROBE_MAX_ITERS; ++k)
+		{
+			covered += histogram[k];
+			budget = k + 1;
+			if (covered >= needed)
+				break;
+		}
+	}
+	else
+		budget = AUTO_PROBE_MAX_ITERS; // Nothing converged: keep the full probe budget
+
+	max_iterations_ = budget;
+
+	auto	end = std::chrono::steady_clock::now();
+
+	ProbeReport	report;
+	report.width = probe_width;
+	report.height = probe_height;
+	report.probe_iterations = AUTO_PROBE_MAX_ITERS;
+	report.max_iterations = budget;
+	report.target_share = target_share;
+	report.achieved_share = converged > 0 ? static_cast<double>(covered) / converged : 0.0;
+	report.converged_share = static_cast<double>(converged) / total;
+	report.elapsed_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+	DEBUG_PRINT("--- Iteration Probe ---");
+	DEBUG_PRINT("  probe size: " << probe_width << " x " << probe_height);
+	DEBUG_PRINT("  picked max iterations: " << budget << "\n");
+
+	return report;
 }
 
 ///////////////
@@ -156,6 +585,76 @@ void	Fractal::generateISPC()
  @param filename	The name of the output file.
 */
 void	Fractal::saveImage(const std::string& filename) const
+{
+	if (pixel_data_.empty())
+		throw std::runtime_error("Error: Nothing to save, call generate() first.");
+
+	writePPM(filename, width_, height_, pixel_data_.data());
+
+	// Print summary to console
+	std::cout	<< BOLD << "Fractal image saved to '" << YELLOW << filename
+				<< RESET << BOLD << "'"
+				<< RESET << std::endl;
+	std::cout	<< "  image size: " << width_ << " x " << height_ << std::endl;
+	std::cout	<< "  fractal order (n): " << n_orig_ << std::endl;
+	std::cout	<< std::fixed << std::setprecision(2) <<
+				"  real axis (x): [" << x_min_ << ", " << x_max_ << "]" << std::endl;
+	std::cout	<< std::fixed << std::setprecision(2) <<
+				"  imag axis (y): [" << y_min_ << ", " << y_max_ << "]" << std::endl;
+	std::cout	<< "\nUse '" << YELLOW << "make png" << RESET << "' to convert the .ppm file to .png format."
+				<< std::endl;
+}
+
+/**
+ @brief Saves the estimated cost of each tile of the last render as a
+ `.ppm` heatmap (diagnostic for the cost-model scheduler).
+
+ Each tile is shaded by its estimated cost per pixel, from black (cheap)
+ over red and yellow to white (most expensive); tile borders are drawn in
+ dark grey so that split tiles are visible.
+
+ @param filename	The name of the output file.
+*/
+void	Fractal::saveCostHeatmap(const std::string& filename) const
+{
+	double	max_density = 0.0;
+	for (const Tile& tile : tiles_)
+		max_density = std::max(max_density, tile.cost / (tile.width * tile.height));
+	if (max_density <= 0.0)
+		throw std::runtime_error("Error: No tile cost estimate available (use '--schedule cost').");
+
+	PixelBuffer<Color>	heatmap(static_cast<size_t>(width_) * height_);
+	for (const Tile& tile : tiles_)
+	{
+		// Black -> red -> yellow -> white
+		double	t = 3.0 * tile.cost / (tile.width * tile.height) / max_density;
+		Color	color = {
+			static_cast<unsigned char>(255.0 * std::min(1.0, t)),
+			static_cast<unsigned char>(255.0 * std::min(1.0, std::max(0.0, t - 1.0))),
+			static_cast<unsigned char>(255.0 * std::min(1.0, std::max(0.0, t - 2.0)))
+		};
+
+		for (int y = tile.y; y < tile.y + tile.height; ++y)
+		{
+			for (int x = tile.x; x < tile.x + tile.width; ++x)
+			{
+				bool	border = (x == tile.x || y == tile.y);
+				heatmap[y * width_ + x] = border ? Color{64, 64, 64} : color;
+			}
+		}
+	}
+
+	writePPM(filename, width_, height_, heatmap.data());
+
+	std::cout	<< BOLD << "Tile cost heatmap saved to '" << YELLOW << filename
+				<< RESET << BOLD << "'" << RESET << std::endl;
+}
+
+/**
+ @brief Writes `pixels` (row-major, `width` x `height`) to a text `.ppm` file.
+*/
+static void	writePPM(const std::string& filename, int width, int height,
+						const Color* pixels)
 {
 	// Open filestream for writing
 	std::ofstream	outFile(filename);
@@ -168,32 +667,20 @@ void	Fractal::saveImage(const std::string& filename) const
 	// it's a text-based (P3) RGB image, of width/height dimensions,
 	// with max color value of 255.
 	outFile << "P3\n";
-	outFile << width_ << " " << height_ << "\n";
+	outFile << width << " " << height << "\n";
 	outFile << "255\n";
 
 	// Write all the pixel data
-	// We Loop through our 1D vector 'pixel_data_' from start to end.
-	for (const Color& pixel : pixel_data_)
+	// We Loop through our 1D buffer 'pixels' from start to end.
+	const Color*	end = pixels + static_cast<size_t>(width) * height;
+	for (const Color* pixel = pixels; pixel != end; ++pixel)
 	{
-		outFile << static_cast<int>(pixel.r) << " "
-				<< static_cast<int>(pixel.g) << " "
-				<< static_cast<int>(pixel.b) << "\n";
+		outFile << static_cast<int>(pixel->r) << " "
+				<< static_cast<int>(pixel->g) << " "
+				<< static_cast<int>(pixel->b) << "\n";
 	}
 
 	outFile.close();
-
-	// Print summary to console
-	std::cout	<< BOLD << "Fractal image saved to '" << YELLOW << filename
-				<< RESET << BOLD << "'"
-				<< RESET << std::endl;
-	std::cout	<< "  image size: " << width_ << " x " << height_ << std::endl;
-	std::cout	<< "  fractal order (n): " << n_orig_ << std::endl;
-	std::cout	<< std::fixed << std::setprecision(2) <<
-				"  real axis (x): [" << x_min_ << ", " << x_max_ << "]" << std::endl;
-	std::cout	<< std::fixed << std::setprecision(2) <<
-				"  imag axis (y): [" << y_min_ << ", " << y_max_ << "]" << std::endl;
-	std::cout	<< "\nUse '" << YELLOW << "make png" << RESET << "' to convert the .ppm file to .png format."
-				<< std::endl;
 }
 
 ///////////////////////////////
@@ -267,10 +754,70 @@ void	Fractal::setupPalette()
 				<< ")\n");
 }
 
+/**
+ @brief Pre-computes the far-field radius and shrink factor used by `farFieldJump()`.
+
+ Newton's step for `z^n - 1` can be written as
+ `z_{k+1} = z_k * (n-1)/n + 1 / (n * z_k^(n-1))`.
+ For large `|z|`, the second term is negligible (relative size
+ `1 / ((n-1) * |z|^n)`), so the iteration just shrinks `z` by `(n-1)/n`
+ per step without changing its direction. Outside the radius where that
+ relative size drops below `FAR_FIELD_REL_ERROR`, whole runs of steps can
+ therefore be computed in closed form.
+
+ Halley's step behaves the same way with a shrink factor of `(n-1)/(n+1)`
+ and a relative error of `4n / ((n+1) * (n-1) * |z|^n)`. Schroeder's step
+ maps far-field points close to the origin in one go, so there is nothing
+ to skip.
+
+ The radius is kept above `1 + 2 * tolerance` so that no root can be within
+ tolerance during skipped steps. A radius of `0.0` disables the fast path
+ (`fast_paths_` off, Schroeder, or `n == 1` where Newton converges in one
+ step anyway).
+*/
+void	Fractal::updateFarField()
+{
+	far_field_radius_ = 0.0;
+	far_field_shrink_ = 0.0;
+	if (!fast_paths_ || n_ < 2 || solver_ == ispc::SOLVER_SCHROEDER)
+		return;
+
+	// Coefficient of the neglected 1/|z|^n term, relative to the shrunk z
+	double	coefficient = 1.0 / (n_ - 1);
+	far_field_shrink_ = static_cast<double>(n_ - 1) / n_;
+	if (solver_ == ispc::SOLVER_HALLEY)
+	{
+		coefficient = 4.0 * n_ / ((n_ + 1.0) * (n_ - 1.0));
+		far_field_shrink_ = static_cast<double>(n_ - 1) / (n_ + 1);
+	}
+
+	double	radius = std::pow(coefficient / FAR_FIELD_REL_ERROR, 1.0 / n_);
+	far_field_radius_ = std::max(radius, 1.0 + 2.0 * tolerance_);
+
+	DEBUG_PRINT("--- Far Field ---");
+	DEBUG_PRINT("  radius: " << far_field_radius_ << ", shrink: " << far_field_shrink_ << "\n");
+}
+
 //////////////////////
 // HELPER FUNCTIONS //
 //////////////////////
 
+/**
+ @brief Performs one step of the selected solver (`solver_`) by updating `z`.
+
+ @return	`true` if the step was successful,
+ 			`false` if the denominator was too small.
+*/
+bool	Fractal::iterationStep(Complex& z)
+{
+	switch (solver_)
+	{
+		case ispc::SOLVER_HALLEY:		return higherOrderStep(z, 2.0);
+		case ispc::SOLVER_SCHROEDER:	return higherOrderStep(z, 1.0);
+		default:						return newtonStep(z);
+	}
+}
+
 /**
  @brief Performs one step of the Newton's iteration by updating `z`.
 
@@ -298,6 +845,76 @@ bool	Fractal::newtonStep(Complex& z)
 	return true;
 }
 
+/**
+ @brief Performs one step of a higher-order iteration by updating `z`.
+
+ `z_{k+1} = z_k - c*f(z_k)*f'(z_k) / (c*f'(z_k)^2 - f(z_k)*f''(z_k))`
+
+ - `c = 2`: Halley's method (cubic convergence).
+ - `c = 1`: Schroeder's method (quadratic, also for multiple roots).
+
+ For `f(z) = z^n - 1`, `f''(z) = n*(n-1)*z^(n-2)`; `z^(n-2)` is computed
+ once and the higher powers are derived from it, so the extra cost over
+ Newton is only a few multiplications.
+
+ @return	`true` if the step was successful,
+ 			`false` if the denominator was too small.
+*/
+bool	Fractal::higherOrderStep(Complex& z, double c)
+{
+	Complex	z_n_minus_1 = {1.0, 0.0};
+	Complex	f_second_z = {0.0, 0.0}; // n == 1: f(z) = z - 1 has no curvature
+	if (n_ >= 2)
+	{
+		Complex	z_n_minus_2 = complexPow(z, n_ - 2);
+		z_n_minus_1 = complexMul(z_n_minus_2, z);
+		f_second_z = complexMul(Complex{static_cast<double>(n_) * (n_ - 1), 0.0}, z_n_minus_2);
+	}
+	Complex	f_z = complexSub(complexMul(z_n_minus_1, z), Complex{1, 0});	// f(z) = z^n - 1
+	Complex	f_prime_z = complexMul(Complex{static_cast<double>(n_), 0.0}, z_n_minus_1);
+
+	Complex	c_complex = {c, 0.0};
+	Complex	num = complexMul(c_complex, complexMul(f_z, f_prime_z));
+	Complex	den = complexSub(complexMul(c_complex, complexMul(f_prime_z, f_prime_z)),
+							complexMul(f_z, f_second_z));
+
+	if (complexAbs(den) < EPSILON)
+		return false; // Avoid division by zero
+
+	z = complexSub(z, complexDiv(num, den));
+	return true;
+}
+
+/**
+ @brief Jumps a far-field point `z` to where it re-enters the far-field radius.
+
+ Computes the number of steps `k` after which `|z| * shrink^k` drops to
+ `far_field_radius_` or below (see `updateFarField()`) and applies them all
+ at once: `z_{k} = z_0 * shrink^k`. This also covers points near the origin:
+ their first Newton step throws them far out, and the jump brings them back.
+
+ Only call this with `|z| > far_field_radius_` and the fast path enabled.
+
+ @return	The number of skipped iterations `k` (at least 1,
+			capped at `max_iterations_`).
+*/
+int	Fractal::farFieldJump(Complex& z) const
+{
+	double	mag_sq = z.real * z.real + z.imag * z.imag;
+
+	// k = ceil(log(|z| / radius) / log(1 / shrink))
+	double	steps = std::ceil((0.5 * std::log(mag_sq) - std::log(far_field_radius_))
+								/ -std::log(far_field_shrink_));
+	int		skipped = static_cast<int>(std::min(std::max(steps, 1.0),
+												static_cast<double>(max_iterations_)));
+
+	double	scale = std::pow(far_field_shrink_, skipped);
+	z.real *= scale;
+	z.imag *= scale;
+
+	return skipped;
+}
+
 /**
  @brief Determines which root the starting point `z_start` converges to
 		and how many iterations it took.
@@ -344,8 +961,20 @@ std::pair<int, int>	Fractal::solvePixel(Complex z_start, int x, int y)
 			}
 		}
 
-		// NOT CONVERGED YET - PERFORM NEWTON STEP
-		if (!newtonStep(z))
+		// FAR FIELD - SKIP THE STEPS SPENT SHRINKING TOWARD THE UNIT CIRCLE
+		// (the loop's ++iter accounts for the last skipped step)
+		if (far_field_radius_ > 0.0
+			&& z.real * z.real + z.imag * z.imag > far_field_radius_ * far_field_radius_)
+		{
+			int	skipped = farFieldJump(z);
+			if (log_this_pixel)
+				DEBUG_PRINT("  Iter " << iter << ": Far field, skipping " << skipped << " iterations");
+			iter += skipped - 1;
+			continue;
+		}
+
+		// NOT CONVERGED YET - PERFORM SOLVER STEP
+		if (!iterationStep(z))
 		{
 			if (log_this_pixel)
 				DEBUG_PRINT("  Iter " << iter << ": Derivative too small, stopping iteration");
@@ -392,4 +1021,18 @@ Color	Fractal::calculateColor(int root_index, int iterations) const
 	unsigned char	b = static_cast<unsigned char>(base_color.b * brightness);
 
 	return {r, g, b};
-}
\ No newline at end of file
+}
+/**
+ @brief Writes a zero to the first byte of `[begin, begin + bytes)` and to
+ every `PAGE_TOUCH_STEP` boundary inside it, mapping each page it spans.
+*/
+static void	touchPages(void* begin, size_t bytes)
+{
+	volatile unsigned char*	bytes_ptr = static_cast<volatile unsigned char*>(begin);
+	uintptr_t				start = reinterpret_cast<uintptr_t>(begin);
+
+	bytes_ptr[0] = 0;
+	for (uintptr_t page = (start / PAGE_TOUCH_STEP + 1) * PAGE_TOUCH_STEP;
+			page < start + bytes; page += PAGE_TOUCH_STEP)
+		bytes_ptr[page - start] = 0;
+}
@@ -0,0 +1,144 @@
+#include "NumaTopology.hpp"
+#include "defines.hpp"	// NUMA_NODE_DIR
+
+#include <fstream>		// For reading sysfs
+#include <string>
+#include <cctype>		// For std::isdigit
+#include <algorithm>	// For std::binary_search, std::sort
+#include <utility>		// For std::pair
+#ifdef __linux__
+# include <dirent.h>	// For opendir, readdir
+# include <pthread.h>	// For pthread_getaffinity_np, pthread_setaffinity_np
+# include <sched.h>		// For cpu_set_t
+#endif
+
+/**
+ @brief Parses a sysfs CPU list such as `0-3,8-11` into CPU numbers.
+*/
+static std::vector<int>	parseCpuList(const std::string& list)
+{
+	std::vector<int>	cpus;
+	size_t				pos = 0;
+
+	while (pos < list.size() && std::isdigit(static_cast<unsigned char>(list[pos])))
+	{
+		size_t	end;
+		int		first = std::stoi(list.substr(pos), &end);
+		int		last = first;
+		pos += end;
+		if (pos < list.size() && list[pos] == '-')
+		{
+			last = std::stoi(list.substr(pos + 1), &end);
+			pos += end + 1;
+		}
+		for (int cpu = first; cpu <= last; ++cpu)
+			cpus.push_back(cpu);
+		if (pos < list.size() && list[pos] == ',')
+			++pos;
+	}
+	return cpus;
+}
+
+/**
+ @brief Reads the CPUs of every NUMA node from sysfs (`NUMA_NODE_DIR`)
+ and keeps those in the calling thread's affinity mask.
+
+ The node list is read once; the affinity mask on every call, so that a
+ caller restricting its threads (e.g. `taskset`) is respected.
+
+ @return	One CPU list per usable node, ordered by node number; empty
+			if there are fewer than two usable nodes (nothing to place).
+*/
+std::vector<std::vector<int>>	detectNumaNodes()
+{
+#ifdef __linux__
+	static const std::vector<std::vector<int>>	all_nodes = []()
+	{
+		std::vector<std::pair<int, std::vector<int>>>	found;
+
+		DIR*	dir = opendir(NUMA_NODE_DIR);
+		if (dir == nullptr)
+			return std::vector<std::vector<int>>();
+		for (struct dirent* entry = readdir(dir); entry != nullptr; entry = readdir(dir))
+		{
+			std::string	name = entry->d_name;
+			if (name.compare(0, 4, "node") != 0 || name.size() == 4
+				|| !std::isdigit(static_cast<unsigned char>(name[4])))
+				continue;
+
+			std::ifstream	file(std::string(NUMA_NODE_DIR) + "/" + name + "/cpulist");
+			std::string		list;
+			if (std::getline(file, list))
+				found.push_back({std::stoi(name.substr(4)), parseCpuList(list)});
+		}
+		closedir(dir);
+
+		std::sort(found.begin(), found.end());
+		std::vector<std::vector<int>>	nodes;
+		for (const auto& node : found)
+			nodes.push_back(node.second);
+		return nodes;
+	}();
+
+	std::vector<int>	allowed = currentThreadCpus();
+	std::vector<std::vector<int>>	nodes;
+	for (const std::vector<int>& node : all_nodes)
+	{
+		std::vector<int>	cpus;
+		for (int cpu : node)
+		{
+			if (allowed.empty() || std::binary_search(allowed.begin(), allowed.end(), cpu))
+				cpus.push_back(cpu);
+		}
+		if (!cpus.empty())
+			nodes.push_back(cpus);
+	}
+	if (nodes.size() < 2)
+		nodes.clear();
+	return nodes;
+#else
+	return std::vector<std::vector<int>>();
+#endif
+}
+
+/**
+ @brief Returns the sorted CPUs the calling thread may run on.
+*/
+std::vector<int>	currentThreadCpus()
+{
+	std::vector<int>	cpus;
+#ifdef __linux__
+	cpu_set_t	set;
+	CPU_ZERO(&set);
+	if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+		return cpus;
+	for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+	{
+		if (CPU_ISSET(cpu, &set))
+			cpus.push_back(cpu);
+	}
+#endif
+	return cpus;
+}
+
+/**
+ @brief Restricts the calling thread to `cpus` (e.g. the CPUs of one node).
+*/
+bool	pinCurrentThread(const std::vector<int>& cpus)
+{
+#ifdef __linux__
+	if (cpus.empty())
+		return false;
+	cpu_set_t	set;
+	CPU_ZERO(&set);
+	for (int cpu : cpus)
+	{
+		if (cpu >= 0 && cpu < CPU_SETSIZE)
+			CPU_SET(cpu, &set);
+	}
+	return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+	(void)cpus;
+	return false;
+#endif
+}
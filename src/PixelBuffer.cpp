@@ -0,0 +1,54 @@
+#include "PixelBuffer.hpp"
+#include "defines.hpp"	// CACHE_LINE_SIZE, HUGE_PAGE_SIZE
+
+#include <cstdlib>		// For std::aligned_alloc, std::free
+#include <new>			// For std::bad_alloc
+#ifdef __linux__
+# include <sys/mman.h>	// For madvise
+#endif
+
+/**
+ @brief Allocates `bytes` of uninitialized memory for pixel data.
+
+ Buffers of at least half a huge page (e.g. the default 800 x 800 image)
+ are rounded up to whole huge pages, aligned to `HUGE_PAGE_SIZE` and marked
+ for transparent huge pages (fewer TLB misses when workers sweep whole
+ images; at most half the memory is padding). Smaller ones are aligned to
+ `CACHE_LINE_SIZE` so that rows and tiles do not share a cache line with
+ unrelated data.
+
+ Nothing is written here, which saves the pass over memory a zero-fill
+ would cost; pages are mapped by the thread that writes to them first
+ (on NUMA machines, the node's workers, see `TileScheduler::run()`).
+
+ @throws std::bad_alloc	If the allocation fails.
+ @return				`nullptr` for 0 bytes, the memory otherwise.
+*/
+void*	allocatePixelMemory(size_t bytes)
+{
+	if (bytes == 0)
+		return nullptr;
+
+	size_t	alignment = (bytes >= HUGE_PAGE_SIZE / 2) ? HUGE_PAGE_SIZE : CACHE_LINE_SIZE;
+	size_t	rounded = (bytes + alignment - 1) / alignment * alignment; // Required by aligned_alloc
+
+	void*	memory = std::aligned_alloc(alignment, rounded);
+	if (memory == nullptr)
+		throw std::bad_alloc();
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+	// Only a hint: without THP support the buffer just uses regular pages
+	if (alignment == HUGE_PAGE_SIZE)
+		madvise(memory, rounded, MADV_HUGEPAGE);
+#endif
+
+	return memory;
+}
+
+/**
+ @brief Frees memory from `allocatePixelMemory()` (`nullptr` is ignored).
+*/
+void	freePixelMemory(void* memory)
+{
+	std::free(memory);
+}
@@ -0,0 +1,465 @@
+#include "TileScheduler.hpp"
+#include "defines.hpp"	// TILE_SIZE, TILE_SPLIT_FACTOR, MIN_TILE_SIZE, MAX_THREADS_PER_CPU
+#include "NumaTopology.hpp"	// For detectNumaNodes, pinCurrentThread
+
+#include <algorithm>	// For std::min, std::max, std::lower_bound, std::stable_sort
+#include <atomic>		// For the shared tile queue
+#include <thread>		// For std::thread
+#include <cmath>		// For std::lround
+#include <mutex>		// For std::mutex (first worker exception)
+#include <exception>	// For std::exception_ptr
+#include <cstdint>		// For uintptr_t
+#include <utility>		// For std::pair
+
+/**
+ @brief Constructor for the TileScheduler.
+
+ @param width	The image width.
+ @param height	The image height.
+ @param threads	Number of worker threads (0: one per hardware thread,
+				clamped to `maxThreads()`).
+*/
+TileScheduler::TileScheduler(int width, int height, int threads) :
+	width_(width), height_(height), threads_(threads), coarse_width_(0),
+	node_cpus_(detectNumaNodes()), band_rows_(),
+	place_base_(nullptr), place_row_bytes_(0)
+{
+	if (threads_ <= 0)
+		threads_ = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	threads_ = std::min(threads_, maxThreads());
+
+	// Every node used needs at least one worker
+	if (static_cast<int>(node_cpus_.size()) > threads_)
+		node_cpus_.resize(threads_ > 1 ? threads_ : 0);
+	makeBands(); // Equal shares until a cost map or buffer layout is set
+}
+
+/**
+ @brief Sets the coarse iteration map used to estimate tile costs.
+
+ The map is a render of the same viewport at `coarse_width` x
+ `coarse_height`; sample `(i, j)` sits on the full-image pixel
+ `(i * (width-1) / (coarse_width-1), j * (height-1) / (coarse_height-1))`.
+*/
+void	TileScheduler::setCostMap(const std::vector<int>& iterations,
+									int coarse_width, int coarse_height)
+{
+	cost_map_ = iterations;
+	coarse_width_ = coarse_width;
+
+	sample_x_.resize(coarse_width);
+	for (int i = 0; i < coarse_width; ++i)
+		sample_x_[i] = static_cast<int>(std::lround(static_cast<double>(i) * (width_ - 1)
+													/ std::max(1, coarse_width - 1)));
+	sample_y_.resize(coarse_height);
+	for (int j = 0; j < coarse_height; ++j)
+		sample_y_[j] = static_cast<int>(std::lround(static_cast<double>(j) * (height_ - 1)
+													/ std::max(1, coarse_height - 1)));
+}
+
+/**
+ @brief Sets the layout of the output buffer that NUMA bands are aligned to.
+
+ @param base		Address of the buffer's first row.
+ @param row_bytes	Bytes between the starts of two rows.
+*/
+void	TileScheduler::setPlacement(const void* base, size_t row_bytes)
+{
+	place_base_ = static_cast<const unsigned char*>(base);
+	place_row_bytes_ = row_bytes;
+}
+
+/**
+ @brief Splits the image into one equal-height row band per worker.
+
+ This is the classic static partition, kept for comparison. With several
+ NUMA nodes, each node's band is split among that node's workers.
+*/
+std::vector<Tile>	TileScheduler::makeStaticTiles()
+{
+	makeBands();
+
+	std::vector<Tile>	tiles;
+	for (int band = 0; band < nodes(); ++band)
+	{
+		int	workers = 0;
+		for (int t = 0; t < threads_; ++t)
+			workers += (nodeOf(t, threads_) == band);
+
+		int	y_first = band_rows_[band];
+		int	rows = band_rows_[band + 1] - y_first;
+		int	parts = std::min(workers, rows);
+		for (int p = 0; p < parts; ++p)
+		{
+			int	y_start = y_first + static_cast<int>(static_cast<long long>(rows) * p / parts);
+			int	y_end = y_first + static_cast<int>(static_cast<long long>(rows) * (p + 1) / parts);
+			tiles.push_back({0, y_start, width_, y_end - y_start, 0.0, band});
+		}
+	}
+	return tiles;
+}
+
+/**
+ @brief Splits the image into `TILE_SIZE` tiles, ordered by estimated cost.
+
+ Each tile gets a cost estimate from the coarse iteration map. Tiles costing
+ more than `1 / (threads * TILE_SPLIT_FACTOR)` of the total are split in
+ half (down to `MIN_TILE_SIZE`) so that no single tile dominates the end
+ of the render. The result is sorted longest-first, which is what `run()`
+ hands out first.
+
+ Without a cost map, the tiles are returned in row-major order.
+ Tiles never cross a NUMA band boundary.
+*/
+std::vector<Tile>	TileScheduler::makeCostTiles()
+{
+	makeBands();
+
+	std::vector<Tile>	grid;
+	double				total_cost = 0.0;
+
+	for (int band = 0; band < nodes(); ++band)
+	{
+		int	y_end = band_rows_[band + 1];
+		for (int y = band_rows_[band]; y < y_end; y += TILE_SIZE)
+		{
+			for (int x = 0; x < width_; x += TILE_SIZE)
+			{
+				Tile	tile = {x, y, std::min(TILE_SIZE, width_ - x), std::min(TILE_SIZE, y_end - y),
+								0.0, band};
+				if (!cost_map_.empty())
+					tile.cost = estimateCost(tile);
+				total_cost += tile.cost;
+				grid.push_back(tile);
+			}
+		}
+	}
+	if (cost_map_.empty())
+		return grid;
+
+	std::vector<Tile>	tiles;
+	double				max_cost = total_cost / (threads_ * TILE_SPLIT_FACTOR);
+	for (const Tile& tile : grid)
+		splitTile(tile, max_cost, tiles);
+
+	// Longest first; stable to keep row-major order among equal costs
+	std::stable_sort(tiles.begin(), tiles.end(),
+		[](const Tile& a, const Tile& b) { return a.cost > b.cost; });
+
+	return tiles;
+}
+
+/**
+ @brief Runs `work` on every tile, in order, on `threads_` workers.
+
+ Workers (including the calling thread) take the next tile from their
+ band's queue until it is empty, then help with the other bands, so cheap
+ tiles fill the gaps left by expensive ones. With a single node there is
+ one band and thus one shared queue.
+
+ With several NUMA nodes, each worker is pinned to the CPUs of its node and
+ first calls `touch` on its share of the node's band, so that the band's
+ pages are mapped in that node's memory. Tiles are only rendered once all
+ bands are touched; bands of nodes without a worker are touched by anyone.
+ The calling thread's CPU affinity is restored afterwards.
+
+ If a worker thread cannot be started, the render goes on with the workers
+ that did start. The first exception thrown by `work` or `touch` stops all
+ workers from taking further tiles and is rethrown here once every thread
+ has been joined.
+*/
+void	TileScheduler::run(const std::vector<Tile>& tiles,
+							const std::function<void(const Tile&)>& work,
+							const TouchFunction& touch) const
+{
+	struct Band
+	{
+		std::vector<size_t>					tiles;	// Indices into 'tiles', in order
+		std::atomic<size_t>					next{0};
+		std::vector<std::pair<int, int>>	chunks;	// Row ranges to first-touch
+		std::atomic<size_t>					next_chunk{0};
+		bool								has_worker = false;
+	};
+
+	int		workers = static_cast<int>(std::min(static_cast<size_t>(threads_), tiles.size()));
+	int		bands_count = nodes();
+	bool	place = (bands_count > 1);
+
+	std::vector<Band>	bands(bands_count);
+	for (size_t i = 0; i < tiles.size(); ++i)
+		bands[std::min(std::max(tiles[i].band, 0), bands_count - 1)].tiles.push_back(i);
+
+	// First-touch work: each band split evenly among its node's workers
+	size_t	total_chunks = 0;
+	if (place && touch)
+	{
+		for (int band = 0; band < bands_count; ++band)
+		{
+			int	owners = 0;
+			for (int t = 0; t < workers; ++t)
+				owners += (nodeOf(t, workers) == band);
+
+			int	y_first = band_rows_[band];
+			int	rows = band_rows_[band + 1] - y_first;
+			int	parts = std::min(std::max(owners, 1), rows);
+			for (int p = 0; p < parts; ++p)
+				bands[band].chunks.push_back({
+					y_first + static_cast<int>(static_cast<long long>(rows) * p / parts),
+					y_first + static_cast<int>(static_cast<long long>(rows) * (p + 1) / parts)});
+			total_chunks += bands[band].chunks.size();
+		}
+	}
+
+	std::atomic<bool>	ready(false);
+	std::atomic<size_t>	touched(0);
+	std::atomic<bool>	failed(false);
+	std::exception_ptr	error;
+	std::mutex			error_mutex;
+
+	auto	worker = [&](int index)
+	{
+		int	home = nodeOf(index, workers);
+		try
+		{
+			if (place)
+				pinCurrentThread(node_cpus_[home]);
+
+			// Wait until it is known which nodes got a worker
+			while (!ready)
+				std::this_thread::yield();
+
+			// 1. First touch: own band, then bands nobody else will touch
+			for (int k = 0; k < bands_count && !failed; ++k)
+			{
+				Band&	band = bands[(home + k) % bands_count];
+				if (k > 0 && band.has_worker)
+					continue;
+				for (size_t c = band.next_chunk++; c < band.chunks.size() && !failed; c = band.next_chunk++)
+				{
+					touch(band.chunks[c].first, band.chunks[c].second);
+					++touched;
+				}
+			}
+			while (touched < total_chunks && !failed)
+				std::this_thread::yield();
+
+			// 2. Tiles: own band first, then help the others
+			for (int k = 0; k < bands_count && !failed; ++k)
+			{
+				Band&	band = bands[(home + k) % bands_count];
+				for (size_t i = band.next++; i < band.tiles.size() && !failed; i = band.next++)
+					work(tiles[band.tiles[i]]);
+			}
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex>	lock(error_mutex);
+			if (!error)
+				error = std::current_exception();
+			failed = true;
+		}
+	};
+
+	std::vector<int>	caller_cpus;
+	if (place)
+		caller_cpus = currentThreadCpus();
+
+	std::vector<std::thread>	pool;
+	bands[nodeOf(0, workers)].has_worker = true;
+	try
+	{
+		pool.reserve(workers);
+		for (int t = 1; t < workers; ++t)
+		{
+			pool.emplace_back(worker, t);
+			bands[nodeOf(t, workers)].has_worker = true;
+		}
+	}
+	catch (const std::exception&)
+	{
+		// Out of threads (std::system_error) or memory: use the ones we have
+	}
+	ready = true;
+
+	worker(0);
+	for (std::thread& thread : pool)
+		thread.join();
+
+	if (place)
+		pinCurrentThread(caller_cpus);
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
+/**
+ @brief Returns the number of worker threads (resolved from 0 if needed).
+*/
+int	TileScheduler::threads() const
+{
+	return threads_;
+}
+
+/**
+ @brief Returns the number of NUMA nodes (and bands) used; 1 without NUMA.
+*/
+int	TileScheduler::nodes() const
+{
+	return std::max(1, static_cast<int>(node_cpus_.size()));
+}
+
+/**
+ @brief Returns the largest accepted worker count: `MAX_THREADS_PER_CPU`
+ per hardware thread. More workers only add scheduling overhead.
+*/
+int	TileScheduler::maxThreads()
+{
+	int	hardware = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	return hardware * MAX_THREADS_PER_CPU;
+}
+
+/**
+ @brief Estimates the cost of `tile` as its area times the mean cost of the
+ coarse samples inside it (`iterations + 1` each, as even a pixel converging
+ immediately is checked once). Tiles without a sample use the nearest one.
+ Iterations skipped by the far-field fast path count fully, so tiles far
+ from the unit circle are somewhat overestimated.
+*/
+double	TileScheduler::estimateCost(const Tile& tile) const
+{
+	// Range of sample columns / rows that fall inside the tile
+	auto	x_begin = std::lower_bound(sample_x_.begin(), sample_x_.end(), tile.x);
+	auto	x_end = std::lower_bound(x_begin, sample_x_.end(), tile.x + tile.width);
+	auto	y_begin = std::lower_bound(sample_y_.begin(), sample_y_.end(), tile.y);
+	auto	y_end = std::lower_bound(y_begin, sample_y_.end(), tile.y + tile.height);
+
+	// No sample inside: take the one at (or just after) the tile center
+	if (x_begin == x_end)
+	{
+		x_begin = std::lower_bound(sample_x_.begin(), sample_x_.end() - 1, tile.x + tile.width / 2);
+		x_end = x_begin + 1;
+	}
+	if (y_begin == y_end)
+	{
+		y_begin = std::lower_bound(sample_y_.begin(), sample_y_.end() - 1, tile.y + tile.height / 2);
+		y_end = y_begin + 1;
+	}
+
+	double	sum = 0.0;
+	int		count = 0;
+	for (auto j = y_begin; j != y_end; ++j)
+	{
+		for (auto i = x_begin; i != x_end; ++i)
+		{
+			int	index = static_cast<int>(j - sample_y_.begin()) * coarse_width_
+						+ static_cast<int>(i - sample_x_.begin());
+			sum += cost_map_[index] + 1;
+			++count;
+		}
+	}
+
+	return sum / count * tile.width * tile.height;
+}
+
+/**
+ @brief Appends `tile` to `out`, halving it along its longer side
+ (recursively) while it costs more than `max_cost`.
+*/
+void	TileScheduler::splitTile(const Tile& tile, double max_cost, std::vector<Tile>& out) const
+{
+	bool	split_x = tile.width >= tile.height;
+	int		length = split_x ? tile.width : tile.height;
+
+	if (tile.cost <= max_cost || length < 2 * MIN_TILE_SIZE)
+	{
+		out.push_back(tile);
+		return;
+	}
+
+	Tile	first = tile;
+	Tile	second = tile;
+	if (split_x)
+	{
+		first.width = tile.width / 2;
+		second.x = tile.x + first.width;
+		second.width = tile.width - first.width;
+	}
+	else
+	{
+		first.height = tile.height / 2;
+		second.y = tile.y + first.height;
+		second.height = tile.height - first.height;
+	}
+	first.cost = estimateCost(first);
+	second.cost = estimateCost(second);
+
+	splitTile(first, max_cost, out);
+	splitTile(second, max_cost, out);
+}
+
+/**
+ @brief Cuts the image into one band of rows per NUMA node (`band_rows_`).
+
+ Each node gets a share of the rows proportional to its number of workers,
+ weighted by the coarse cost map if there is one. Cuts are moved to the
+ nearest huge-page boundary of the output buffer (see `alignBandRow()`), so
+ that no huge page is shared by two nodes.
+*/
+void	TileScheduler::makeBands()
+{
+	band_rows_.assign(1, 0);
+	if (nodes() > 1)
+	{
+		// Cumulative cost of the rows above each row
+		std::vector<double>	cumulative(height_ + 1, 0.0);
+		for (int y = 0; y < height_; ++y)
+		{
+			double	cost = 1.0;
+			if (!cost_map_.empty())
+				cost = estimateCost({0, y, width_, 1, 0.0, 0});
+			cumulative[y + 1] = cumulative[y] + cost;
+		}
+
+		int	workers_before = 0;
+		for (int band = 1; band < nodes(); ++band)
+		{
+			for (int t = 0; t < threads_; ++t)
+				workers_before += (nodeOf(t, threads_) == band - 1);
+
+			double	target = cumulative[height_] * workers_before / threads_;
+			int		row = static_cast<int>(std::lower_bound(cumulative.begin(), cumulative.end(), target)
+											- cumulative.begin());
+			row = std::min(std::max(alignBandRow(row), band_rows_.back()), height_);
+			band_rows_.push_back(row);
+		}
+	}
+	band_rows_.push_back(height_);
+}
+
+/**
+ @brief Returns the first row starting at or after the huge-page boundary
+ of the output buffer nearest to `row` (`row` itself without a layout).
+*/
+int	TileScheduler::alignBandRow(int row) const
+{
+	if (place_base_ == nullptr || place_row_bytes_ == 0)
+		return row;
+
+	uintptr_t	base = reinterpret_cast<uintptr_t>(place_base_);
+	uintptr_t	address = base + static_cast<uintptr_t>(row) * place_row_bytes_;
+	uintptr_t	boundary = (address + HUGE_PAGE_SIZE / 2) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+	if (boundary <= base)
+		return 0;
+
+	uintptr_t	aligned = (boundary - base + place_row_bytes_ - 1) / place_row_bytes_;
+	return static_cast<int>(std::min(aligned, static_cast<uintptr_t>(height_)));
+}
+
+/**
+ @brief Returns the NUMA node of worker `worker` out of `workers`
+ (consecutive workers share a node).
+*/
+int	TileScheduler::nodeOf(int worker, int workers) const
+{
+	return static_cast<int>(static_cast<long long>(worker) * nodes() / std::max(workers, 1));
+}
@@ -9,6 +9,10 @@
 #include <sstream>	// Helper: For std::stringstream
 
 static std::string	genOutputFilename(int n);
+static void			printProbeReport(const ProbeReport& report);
+static void			printRenderStats(Solver solver, const RenderStats& stats);
+static void			configureFractal(Fractal& fractal, const Args& args);
+static void			runSolverBench(const Args& args);
 
 /**
  @brief Main entry point for the Newton Fractal generator.
@@ -20,6 +24,16 @@ static std::string	genOutputFilename(int n);
  - `<n>` (required): The degree of the polynomial.
  - `[width]` (optional): The width of the output image (default: 800).
  - `[height]` (optional): The height of the output image (default: 800).
+ - `--tol <value>` (optional): Convergence tolerance.
+ - `--iters <value|auto>` (optional): Max iterations, or `auto` to pick them
+   from a low-resolution probe pass.
+ - `--fast <on|off>` (optional): Far-field fast path (same results, default: on).
+ - `--solver <newton|halley|schroeder>` (optional): Iteration scheme.
+ - `--bench <on|off>` (optional): Compare iterations per pixel and wall time
+   of all solvers instead of saving an image.
+ - `--threads <value>` (optional): Worker threads (0: one per hardware thread).
+ - `--schedule <cost|static>` (optional): Tile scheduling strategy.
+ - `--heatmap <on|off>` (optional): Also save the estimated tile costs (needs `--schedule cost`).
 
  Example usage:
  ```
@@ -34,13 +48,25 @@ int	main (int argc, char **argv)
 		// Parse and validate command-line arguments
 		Args	args(argc, argv);
 
+		if (args.bench)
+		{
+			runSolverBench(args);
+			return 0;
+		}
+
 		// Create Fractal object and generate the fractal data
 		Fractal	fractal(args.n_orig, args.width, args.height);
+		configureFractal(fractal, args);
+		if (args.auto_iterations)
+			printProbeReport(fractal.autoTuneIterations(AUTO_TARGET_SHARE));
 		fractal.generate();
+		printRenderStats(args.solver, fractal.stats());
 
 		// Save fractal data to file
 		std::string	outputFilename = genOutputFilename(args.n_orig);
 		fractal.saveImage(outputFilename);
+		if (args.heatmap)
+			fractal.saveCostHeatmap(outputFilename.substr(0, outputFilename.size() - 4) + "_cost.ppm");
 	}
 	catch(const std::exception& e)
 	{
@@ -75,3 +101,91 @@ static std::string	genOutputFilename(int n)
 
 	return ss.str();
 }
+
+/**
+ @brief Prints the cost and result of the automatic iteration probe.
+
+ @param report	The report returned by `Fractal::autoTuneIterations()`.
+*/
+static void	printProbeReport(const ProbeReport& report)
+{
+	std::cout	<< BOLD << "Iteration probe picked max iterations: " << YELLOW
+				<< report.max_iterations << RESET << std::endl;
+	std::cout	<< "  probe size: " << report.width << " x " << report.height
+				<< " (budget " << report.probe_iterations << ")" << std::endl;
+	std::cout	<< std::fixed << std::setprecision(2)
+				<< "  probe time: " << report.elapsed_ms << " ms" << std::endl;
+	std::cout	<< std::fixed << std::setprecision(2)
+				<< "  converging pixels kept: " << report.achieved_share * 100.0
+				<< "% (target " << report.target_share * 100.0 << "%, "
+				<< report.converged_share * 100.0 << "% of probe converged)\n" << std::endl;
+}
+
+/**
+ @brief Prints the solver used for the render and what it cost.
+*/
+static void	printRenderStats(Solver solver, const RenderStats& stats)
+{
+	std::cout	<< std::fixed << std::setprecision(2)
+				<< BOLD << "Rendered with " << YELLOW << Fractal::solverName(solver) << RESET
+				<< ": " << stats.mean_iterations << " iterations/pixel, "
+				<< stats.elapsed_ms << " ms" << std::endl;
+	std::cout	<< "  " << stats.tiles << " tiles on " << stats.threads << " threads";
+	if (stats.nodes > 1)
+		std::cout	<< ", " << stats.nodes << " NUMA nodes";
+	if (stats.coarse_ms > 0.0)
+		std::cout	<< " (coarse cost pass: " << stats.coarse_ms << " ms)";
+	std::cout	<< "\n" << std::endl;
+}
+
+/**
+ @brief Applies the command-line settings (except `--iters auto`) to `fractal`.
+*/
+static void	configureFractal(Fractal& fractal, const Args& args)
+{
+	fractal.setTolerance(args.tolerance);
+	fractal.setMaxIterations(args.max_iterations);
+	fractal.setFastPaths(args.fast_paths);
+	fractal.setSolver(args.solver);
+	fractal.setThreads(args.threads);
+	fractal.setCostScheduling(args.cost_schedule);
+	fractal.setCostHeatmap(args.heatmap);
+}
+
+/**
+ @brief Renders the fractal once per solver and prints a comparison table
+ (iterations per pixel, converged share, wall time). No image is saved.
+
+ With `--iters auto`, each solver gets its own probe-picked budget,
+ as higher-order solvers need fewer iterations.
+*/
+static void	runSolverBench(const Args& args)
+{
+	const Solver	solvers[] = {ispc::SOLVER_NEWTON, ispc::SOLVER_HALLEY, ispc::SOLVER_SCHROEDER};
+
+	std::cout	<< BOLD << "Solver benchmark (n=" << args.n_orig << ", "
+				<< args.width << " x " << args.height << ")" << RESET << std::endl;
+	std::cout	<< "  " << std::left << std::setw(11) << "solver" << std::right
+				<< std::setw(11) << "max iters" << std::setw(14) << "iters/pixel"
+				<< std::setw(12) << "converged" << std::setw(12) << "time (ms)" << std::endl;
+
+	for (Solver solver : solvers)
+	{
+		Fractal	fractal(args.n_orig, args.width, args.height);
+		configureFractal(fractal, args);
+		fractal.setSolver(solver);
+
+		int	max_iterations = args.max_iterations;
+		if (args.auto_iterations)
+			max_iterations = fractal.autoTuneIterations(AUTO_TARGET_SHARE).max_iterations;
+		fractal.generate();
+
+		const RenderStats&	stats = fractal.stats();
+		std::cout	<< std::fixed << std::setprecision(2)
+					<< "  " << std::left << std::setw(11) << Fractal::solverName(solver) << std::right
+					<< std::setw(11) << max_iterations
+					<< std::setw(14) << stats.mean_iterations
+					<< std::setw(11) << stats.converged_share * 100.0 << "%"
+					<< std::setw(12) << stats.elapsed_ms << std::endl;
+	}
+}
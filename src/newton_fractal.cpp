@@ -0,0 +1,131 @@
+#include "newton_fractal.h"
+#include "Fractal.hpp"
+#include "defines.hpp"	// Default values, Solver
+
+#include <new>			// For std::bad_alloc
+#include <stdexcept>	// For std::invalid_argument
+#include <cstring>		// For std::memcpy
+
+static_assert(static_cast<int>(NF_SOLVER_NEWTON) == static_cast<int>(ispc::SOLVER_NEWTON)
+			&& static_cast<int>(NF_SOLVER_HALLEY) == static_cast<int>(ispc::SOLVER_HALLEY)
+			&& static_cast<int>(NF_SOLVER_SCHROEDER) == static_cast<int>(ispc::SOLVER_SCHROEDER),
+			"NfSolver must match the kernel's Solver enum");
+
+static NfStatus	renderInto(const NfParams* params, const RenderTarget& target, NfStats* stats);
+
+// Fills 'params' with the executable's defaults
+void	nfDefaultParams(NfParams* params, int n, int width, int height)
+{
+	if (params == nullptr)
+		return;
+
+	params->n = n;
+	params->width = width;
+	params->height = height;
+	params->tolerance = DEF_TOLERANCE;
+	params->max_iterations = MAX_ITERS;
+	params->solver = NF_SOLVER_NEWTON;
+	params->fast_paths = 1;
+	params->threads = DEF_THREADS;
+	params->cost_schedule = 1;
+	params->x_min = DEF_VIEW_MIN_X;
+	params->x_max = DEF_VIEW_MAX_X;
+	params->y_min = DEF_VIEW_MIN_Y;
+	params->y_max = DEF_VIEW_MAX_Y;
+}
+
+// Renders colors into the caller's 'rgb' buffer (3 bytes per pixel)
+NfStatus	nfRenderRGB(const NfParams* params, unsigned char* rgb, size_t row_stride,
+						NfStats* stats)
+{
+	if (params == nullptr || rgb == nullptr)
+		return NF_ERROR_INVALID_ARGUMENT;
+
+	RenderTarget	target = {};
+	target.rgb = rgb;
+	target.rgb_stride = (row_stride != 0) ? row_stride : static_cast<size_t>(params->width) * 3;
+	return renderInto(params, target, stats);
+}
+
+// Renders root indices and iteration counts into the caller's buffers
+NfStatus	nfRenderRaw(const NfParams* params, int* root_indices, int* iterations,
+						size_t row_stride, NfStats* stats)
+{
+	if (params == nullptr || root_indices == nullptr || iterations == nullptr)
+		return NF_ERROR_INVALID_ARGUMENT;
+
+	RenderTarget	target = {};
+	target.root_indices = root_indices;
+	target.iterations = iterations;
+	target.raw_stride = (row_stride != 0) ? row_stride : static_cast<size_t>(params->width);
+	return renderInto(params, target, stats);
+}
+
+const char*	nfStatusString(NfStatus status)
+{
+	switch (status)
+	{
+		case NF_OK:						return "success";
+		case NF_ERROR_INVALID_ARGUMENT:	return "invalid argument";
+		case NF_ERROR_OUT_OF_MEMORY:	return "out of memory";
+		default:						return "internal error";
+	}
+}
+
+/**
+ @brief Configures a `Fractal` from `params` and renders it into `target`.
+
+ Exceptions must not cross the C boundary, so they are mapped to status codes:
+ `std::invalid_argument` (bad parameters) and `std::bad_alloc` get their own
+ codes, anything else is reported as `NF_ERROR_INTERNAL`.
+*/
+static NfStatus	renderInto(const NfParams* params, const RenderTarget& target, NfStats* stats)
+{
+	// C callers can store any int in the enum; loading such a value as
+	// 'NfSolver' is undefined in C++, so read its bytes as an int
+	static_assert(sizeof(NfSolver) == sizeof(int), "NfSolver must be int-sized");
+	int	solver;
+	std::memcpy(&solver, &params->solver, sizeof(solver));
+	if (solver < NF_SOLVER_NEWTON || solver > NF_SOLVER_SCHROEDER)
+		return NF_ERROR_INVALID_ARGUMENT;
+
+	try
+	{
+		Fractal	fractal(params->n, params->width, params->height);
+		fractal.setTolerance(params->tolerance);
+		fractal.setSolver(static_cast<Solver>(solver));
+		fractal.setFastPaths(params->fast_paths != 0);
+		fractal.setThreads(params->threads);
+		fractal.setCostScheduling(params->cost_schedule != 0);
+		fractal.setViewport(params->x_min, params->x_max, params->y_min, params->y_max);
+
+		int	max_iterations = params->max_iterations;
+		if (max_iterations == 0)
+			max_iterations = fractal.autoTuneIterations(AUTO_TARGET_SHARE).max_iterations;
+		else
+			fractal.setMaxIterations(max_iterations);
+
+		fractal.render(target);
+
+		if (stats != nullptr)
+		{
+			stats->elapsed_ms = fractal.stats().elapsed_ms;
+			stats->mean_iterations = fractal.stats().mean_iterations;
+			stats->converged_share = fractal.stats().converged_share;
+			stats->max_iterations = max_iterations;
+		}
+		return NF_OK;
+	}
+	catch (const std::invalid_argument&)
+	{
+		return NF_ERROR_INVALID_ARGUMENT;
+	}
+	catch (const std::bad_alloc&)
+	{
+		return NF_ERROR_OUT_OF_MEMORY;
+	}
+	catch (...)
+	{
+		return NF_ERROR_INTERNAL;
+	}
+}